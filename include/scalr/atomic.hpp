@@ -0,0 +1,209 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_ATOMIC_HPP
+#define SCALR_ATOMIC_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Size of the cache line that shards of a counter are padded to, so that
+// updates to neighboring shards do not invalidate each other
+constexpr std::size_t cache_line_size = 64;
+
+// Read-modify-write addition on integral atomics is a single instruction
+template <typename Rep>
+typename std::enable_if<std::is_integral<Rep>::value, Rep>::type atomic_add(
+    std::atomic<Rep>& value, Rep operand, std::memory_order order) {
+  return value.fetch_add(operand, order);
+}
+
+// Floating-point atomics have no fetch_add before C++20; the sum is retried
+// until no other thread has changed the value in between
+template <typename Rep>
+typename std::enable_if<!std::is_integral<Rep>::value, Rep>::type atomic_add(
+    std::atomic<Rep>& value, Rep operand, std::memory_order order) {
+  Rep expected = value.load(std::memory_order_relaxed);
+  while (!value.compare_exchange_weak(expected, expected + operand, order,
+                                      std::memory_order_relaxed)) {
+  }
+  return expected;
+}
+
+// Threads are numbered in the order they first update a sharded counter
+inline std::size_t thread_ordinal() {
+  static std::atomic<std::size_t> next(0);
+  static thread_local const std::size_t ordinal =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return ordinal;
+}
+
+}  // namespace detail
+
+/* Class template atomic quantity
+ *
+ * An atomic value of quantity<Rep, Unit> with the interface of std::atomic.
+ * Quantities in other units are converted before they are stored or added.
+ */
+template <typename Rep, typename Unit>
+class atomic_quantity {
+ public:
+  using value_type = quantity<Rep, Unit>;
+
+  constexpr atomic_quantity() noexcept : value_(Rep(0)) {}
+  constexpr atomic_quantity(const value_type& q) noexcept
+      : value_(q.value()) {}
+
+  atomic_quantity(const atomic_quantity&) = delete;
+  atomic_quantity& operator=(const atomic_quantity&) = delete;
+
+  bool is_lock_free() const noexcept { return value_.is_lock_free(); }
+
+  void store(const value_type& q,
+             std::memory_order order = std::memory_order_seq_cst) noexcept {
+    value_.store(q.value(), order);
+  }
+
+  value_type load(
+      std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return value_type(value_.load(order));
+  }
+
+  operator value_type() const noexcept { return load(); }
+
+  value_type operator=(const value_type& q) noexcept {
+    store(q);
+    return q;
+  }
+
+  value_type exchange(
+      const value_type& q,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return value_type(value_.exchange(q.value(), order));
+  }
+
+  bool compare_exchange_weak(
+      value_type& expected, const value_type& desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    Rep raw = expected.value();
+    const bool exchanged = value_.compare_exchange_weak(raw, desired.value(),
+                                                        order);
+    expected = value_type(raw);
+    return exchanged;
+  }
+
+  bool compare_exchange_strong(
+      value_type& expected, const value_type& desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    Rep raw = expected.value();
+    const bool exchanged = value_.compare_exchange_strong(raw, desired.value(),
+                                                          order);
+    expected = value_type(raw);
+    return exchanged;
+  }
+
+  // Adds to the value and returns the value before the addition
+  value_type fetch_add(
+      const value_type& q,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return value_type(detail::atomic_add(value_, q.value(), order));
+  }
+
+  value_type fetch_sub(
+      const value_type& q,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return value_type(detail::atomic_add(value_, Rep(-q.value()), order));
+  }
+
+  value_type operator+=(const value_type& q) noexcept {
+    return fetch_add(q) + q;
+  }
+
+  value_type operator-=(const value_type& q) noexcept {
+    return fetch_sub(q) - q;
+  }
+
+ private:
+  std::atomic<Rep> value_;
+};
+
+/* Class template sharded quantity counter
+ *
+ * A sum of quantities updated by many threads. Each thread adds to one of
+ * Shards cache-line-sized atomic shards with relaxed ordering, assigned in
+ * the order threads first update any counter, so concurrent updates rarely
+ * touch the same cache line. load() sums the shards on demand; the total is
+ * exact once updates have finished and a consistent snapshot is not needed
+ * while they are running.
+ */
+template <typename Rep, typename Unit, std::size_t Shards = 16>
+class sharded_counter {
+  static_assert(Shards > 0, "a sharded counter requires at least one shard");
+
+ public:
+  using value_type = quantity<Rep, Unit>;
+
+  sharded_counter() = default;
+  sharded_counter(const sharded_counter&) = delete;
+  sharded_counter& operator=(const sharded_counter&) = delete;
+
+  void add(const value_type& q) noexcept {
+    add(q, detail::thread_ordinal());
+  }
+
+  // Adds to the shard selected by a caller-provided index, such as the index
+  // of a worker in a pool
+  void add(const value_type& q, std::size_t index) noexcept {
+    shards_[index % Shards].value.fetch_add(q, std::memory_order_relaxed);
+  }
+
+  sharded_counter& operator+=(const value_type& q) noexcept {
+    add(q);
+    return *this;
+  }
+
+  value_type load() const noexcept {
+    value_type sum(Rep(0));
+    for (const shard& s : shards_) {
+      sum += s.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  void reset() noexcept {
+    for (shard& s : shards_) {
+      s.value.store(value_type(Rep(0)), std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  // Shards are padded to a cache line rather than aligned to one. Values a
+  // cache line apart never share a line, and the counter keeps fundamental
+  // alignment, which operator new guarantees before C++17, as for
+  // quantity_vec.
+  struct shard {
+    atomic_quantity<Rep, Unit> value;
+    char padding[detail::cache_line_size - sizeof(atomic_quantity<Rep, Unit>)];
+  };
+
+  static_assert(sizeof(atomic_quantity<Rep, Unit>) < detail::cache_line_size,
+                "atomic quantities must be smaller than a cache line");
+
+  shard shards_[Shards];
+};
+
+}  // namespace scalr
+
+#endif
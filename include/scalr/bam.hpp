@@ -0,0 +1,130 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_BAM_HPP
+#define SCALR_BAM_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+#include "scalr/named_quantity/angle.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+namespace detail {
+
+// One turn split into 2^N steps for an N-bit unsigned representation
+template <typename UInt>
+struct bam_ratio {
+  static_assert(std::is_unsigned<UInt>::value,
+                "binary angles require an unsigned integral type");
+  static_assert(std::numeric_limits<UInt>::digits <= 32,
+                "binary angle steps must fit in std::ratio");
+
+  using type =
+      std::ratio<1, (intmax_t(1) << std::numeric_limits<UInt>::digits)>;
+};
+
+template <typename Rep, typename Unit, typename = void>
+struct is_binary_angle : std::false_type {};
+
+template <typename Rep, typename Unit>
+struct is_binary_angle<
+    Rep, Unit,
+    typename std::enable_if<std::is_unsigned<Rep>::value &&
+                            std::numeric_limits<Rep>::digits <= 32>::type>
+    : std::integral_constant<
+          bool, std::is_same<typename Unit::dimension,
+                             angle_dimension>::value &&
+                    unit_pi<Unit>::value == 0 &&
+                    std::ratio_equal<typename Unit::ratio,
+                                     typename bam_ratio<Rep>::type>::value> {
+};
+
+// Two's complement reading of an unsigned value without relying on
+// implementation-defined narrowing
+template <typename UInt>
+constexpr typename std::make_signed<UInt>::type bam_signed(UInt value) {
+  using S = typename std::make_signed<UInt>::type;
+  return value <= static_cast<UInt>(std::numeric_limits<S>::max())
+             ? static_cast<S>(value)
+             : static_cast<S>(
+                   static_cast<S>(static_cast<UInt>(
+                       value - static_cast<UInt>(
+                                   std::numeric_limits<S>::max()) -
+                       1)) +
+                   std::numeric_limits<S>::min());
+}
+
+}  // namespace detail
+
+/* Binary angular measurement
+ *
+ * An unsigned N-bit value counting 2^-N turns. Addition and subtraction wrap
+ * around a full turn through unsigned overflow, so binary angles never need
+ * normalization. Conversions to floating degrees, gradians and turns are
+ * exact.
+ */
+template <typename UInt>
+using bam = angle<UInt, typename detail::bam_ratio<UInt>::type>;
+
+using bam8 = bam<std::uint8_t>;
+using bam16 = bam<std::uint16_t>;
+using bam32 = bam<std::uint32_t>;
+
+// Converts an angle in any unit to the nearest binary angle, ties to even,
+// wrapping it into a single turn. Values are reduced by whole turns in the
+// binary unit first, which is exact, so large inputs do not overflow.
+template <class Target, class Rep, class Unit>
+typename std::enable_if<
+    detail::is_binary_angle<typename Target::value_type,
+                            typename Target::unit>::value &&
+        std::is_floating_point<Rep>::value,
+    Target>::type
+bam_cast(const quantity<Rep, Unit>& other) {
+  using T = typename Target::value_type;
+  using steps = quantity<Rep, typename Target::unit>;
+  return Target(static_cast<T>(static_cast<intmax_t>(detail::round_half_even(
+      std::remainder(steps(other).value(),
+                     static_cast<Rep>(Target::ratio::den))))));
+}
+
+template <class Target, class Rep, class Unit>
+constexpr typename std::enable_if<
+    detail::is_binary_angle<typename Target::value_type,
+                            typename Target::unit>::value &&
+        !std::is_floating_point<Rep>::value,
+    Target>::type
+bam_cast(const quantity<Rep, Unit>& other) {
+  using T = typename Target::value_type;
+  return Target(static_cast<T>(
+      round<quantity<intmax_t, typename Target::unit>>(other).value()));
+}
+
+// The signed angle from b to a with the smallest magnitude, in [-1/2, 1/2)
+// turns
+template <typename UInt, typename Unit,
+          typename std::enable_if<detail::is_binary_angle<UInt, Unit>::value,
+                                  int>::type = 0>
+constexpr quantity<typename std::make_signed<UInt>::type, Unit>
+shortest_difference(const quantity<UInt, Unit>& a,
+                    const quantity<UInt, Unit>& b) {
+  using S = typename std::make_signed<UInt>::type;
+  using result_type = quantity<S, Unit>;
+  return result_type(detail::bam_signed<UInt>(
+      static_cast<UInt>(a.value() - b.value())));
+}
+
+}  // namespace scalr
+
+#endif
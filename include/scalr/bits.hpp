@@ -0,0 +1,87 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_BITS_HPP
+#define SCALR_BITS_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace scalr {
+namespace detail {
+
+// Bit manipulation and variable-length integer encoding shared by the
+// histogram, compressed series and nullable column implementations
+
+// Index of the highest set bit of a nonzero value
+inline unsigned highest_bit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+  unsigned bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+// Index of the lowest set bit of a nonzero value
+inline unsigned lowest_bit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+  unsigned bit = 0;
+  while (!(value & 1)) {
+    value >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+// Number of set bits
+inline unsigned bit_count(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_popcountll(value));
+#else
+  unsigned count = 0;
+  for (; value; value &= value - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// LEB128 encoding of unsigned integers
+inline void put_varint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+template <class InputIt>
+bool get_varint(InputIt& first, InputIt last, std::uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; first != last && shift < 64; shift += 7) {
+    const std::uint8_t byte = static_cast<std::uint8_t>(*first++);
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace detail
+}  // namespace scalr
+
+#endif
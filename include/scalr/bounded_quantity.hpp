@@ -0,0 +1,287 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_BOUNDED_QUANTITY_HPP
+#define SCALR_BOUNDED_QUANTITY_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ratio>
+#include <stdexcept>
+#include <type_traits>
+
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+
+//******************************
+// Bound Policies
+//******************************
+
+// What a bounded quantity does with a value outside of [lo, hi]
+struct clamp_bounds {
+  template <typename Rep>
+  static Rep apply(Rep value, Rep lo, Rep hi) {
+    return value < lo ? lo : (hi < value ? hi : value);
+  }
+};
+
+// Wraps values into the half-open period [lo, hi), as for angles
+struct wrap_bounds {
+  // A tiny negative remainder plus the period may round up to hi, which is
+  // mapped back to lo
+  template <typename Rep>
+  static typename std::enable_if<std::is_floating_point<Rep>::value, Rep>::type
+  apply(Rep value, Rep lo, Rep hi) {
+    const Rep period = hi - lo;
+    const Rep wrapped = std::fmod(value - lo, period);
+    const Rep result = lo + (wrapped < 0 ? wrapped + period : wrapped);
+    return hi <= result ? lo : result;
+  }
+
+  // Integers are reduced in the unsigned type of the same width, where the
+  // period always fits and differences cannot overflow. The value and lo are
+  // reduced modulo the period separately before they are subtracted.
+  template <typename Rep>
+  static typename std::enable_if<!std::is_floating_point<Rep>::value, Rep>::type
+  apply(Rep value, Rep lo, Rep hi) {
+    using U = typename std::make_unsigned<Rep>::type;
+    const U period = static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo));
+    const U v = floored_remainder(value, period);
+    const U l = floored_remainder(lo, period);
+    const U offset = static_cast<U>(v < l ? v + (period - l) : v - l);
+    return static_cast<Rep>(static_cast<U>(static_cast<U>(lo) + offset));
+  }
+
+ private:
+  template <typename Rep, typename U>
+  static U floored_remainder(Rep value, U period) {
+    const U magnitude =
+        static_cast<U>(value < 0 ? U(0) - static_cast<U>(value)
+                                 : static_cast<U>(value));
+    const U r = static_cast<U>(magnitude % period);
+    return value < 0 && r != 0 ? static_cast<U>(period - r) : r;
+  }
+};
+
+// Checks in debug builds only
+struct assert_bounds {
+  template <typename Rep>
+  static Rep apply(Rep value, Rep lo, Rep hi) {
+    assert(!(value < lo) && !(hi < value) && "quantity out of bounds");
+    (void)lo;
+    (void)hi;
+    return value;
+  }
+};
+
+struct throw_bounds {
+  template <typename Rep>
+  static Rep apply(Rep value, Rep lo, Rep hi) {
+    if (value < lo || hi < value) {
+      throw std::out_of_range("quantity out of bounds");
+    }
+    return value;
+  }
+};
+
+namespace detail {
+
+template <typename Rep, typename Ratio>
+constexpr Rep ratio_value() {
+  return static_cast<Rep>(Ratio::num) / static_cast<Rep>(Ratio::den);
+}
+
+// Bounds of a sum are known statically except under wrapping, which keeps
+// the bounds and wraps the sum again
+template <typename Q, typename Min, typename Max, typename Policy>
+struct bounded_sum;
+
+// Negation flips the bounds except under wrapping, as for sums
+template <typename Q, typename Min, typename Max, typename Policy>
+struct bounded_negation;
+
+}  // namespace detail
+
+/* Class template quantity with a static range
+ *
+ * A quantity Q whose value lies in [Min, Max], both std::ratio values in the
+ * unit of Q. Construction from an arbitrary quantity applies the Policy:
+ * clamp_bounds, wrap_bounds (to [Min, Max)), assert_bounds or throw_bounds.
+ * Sums, differences and negations of bounded quantities have statically
+ * derived bounds and are not checked again, except that wrapped values are
+ * wrapped again into the same bounds. assume() skips the check for values
+ * already validated in bulk with within_bounds().
+ */
+template <typename Q, typename Min, typename Max,
+          typename Policy = assert_bounds>
+class bounded_quantity {
+  using rep = typename Q::value_type;
+  static_assert(std::ratio_less<Min, Max>::value,
+                "lower bound must be less than upper bound");
+  static_assert(std::is_floating_point<rep>::value ||
+                    (Min::den == 1 && Max::den == 1),
+                "bounds of integral quantities must be integers");
+
+  struct unchecked {};
+  constexpr bounded_quantity(const Q& q, unchecked) : value_(q) {}
+
+ public:
+  using quantity_type = Q;
+  using value_type = rep;
+  using unit = typename Q::unit;
+  using lower = Min;
+  using upper = Max;
+  using policy = Policy;
+
+  static constexpr value_type lower_value() {
+    return detail::ratio_value<value_type, Min>();
+  }
+
+  static constexpr value_type upper_value() {
+    return detail::ratio_value<value_type, Max>();
+  }
+
+  template <typename Rep2, typename Unit2>
+  explicit bounded_quantity(const scalr::quantity<Rep2, Unit2>& q)
+      : value_(Policy::apply(Q(q).value(), lower_value(), upper_value())) {}
+
+  // A value known to be within bounds
+  static constexpr bounded_quantity assume(const Q& q) {
+    return bounded_quantity(q, unchecked());
+  }
+
+  constexpr Q quantity() const { return value_; }
+  constexpr value_type value() const { return value_.value(); }
+  constexpr operator Q() const { return value_; }
+
+  constexpr typename detail::bounded_negation<Q, Min, Max, Policy>::type
+  operator-() const {
+    return detail::bounded_negation<Q, Min, Max, Policy>::apply(-value_);
+  }
+
+ private:
+  Q value_;
+};
+
+namespace detail {
+
+template <typename Q, typename Min, typename Max, typename Policy>
+struct bounded_sum {
+  template <typename Min2, typename Max2>
+  using type = bounded_quantity<Q, std::ratio_add<Min, Min2>,
+                                std::ratio_add<Max, Max2>, Policy>;
+
+  template <typename Min2, typename Max2>
+  static constexpr type<Min2, Max2> apply(const Q& sum) {
+    return type<Min2, Max2>::assume(sum);
+  }
+};
+
+template <typename Q, typename Min, typename Max>
+struct bounded_sum<Q, Min, Max, wrap_bounds> {
+  template <typename, typename>
+  using type = bounded_quantity<Q, Min, Max, wrap_bounds>;
+
+  template <typename, typename>
+  static type<Min, Max> apply(const Q& sum) {
+    return type<Min, Max>(sum);
+  }
+};
+
+template <typename Q, typename Min, typename Max, typename Policy>
+struct bounded_negation {
+  using type = bounded_quantity<Q, std::ratio_multiply<Max, std::ratio<-1>>,
+                                std::ratio_multiply<Min, std::ratio<-1>>,
+                                Policy>;
+
+  static constexpr type apply(const Q& negated) {
+    return type::assume(negated);
+  }
+};
+
+template <typename Q, typename Min, typename Max>
+struct bounded_negation<Q, Min, Max, wrap_bounds> {
+  using type = bounded_quantity<Q, Min, Max, wrap_bounds>;
+
+  static type apply(const Q& negated) { return type(negated); }
+};
+
+}  // namespace detail
+
+template <typename Q, typename Min1, typename Max1, typename Min2,
+          typename Max2, typename Policy>
+constexpr typename detail::bounded_sum<Q, Min1, Max1,
+                                       Policy>::template type<Min2, Max2>
+operator+(const bounded_quantity<Q, Min1, Max1, Policy>& left,
+          const bounded_quantity<Q, Min2, Max2, Policy>& right) {
+  return detail::bounded_sum<Q, Min1, Max1, Policy>::template apply<Min2, Max2>(
+      left.quantity() + right.quantity());
+}
+
+template <typename Q, typename Min1, typename Max1, typename Min2,
+          typename Max2, typename Policy>
+constexpr typename detail::bounded_sum<Q, Min1, Max1, Policy>::template type<
+    std::ratio_multiply<Max2, std::ratio<-1>>,
+    std::ratio_multiply<Min2, std::ratio<-1>>>
+operator-(const bounded_quantity<Q, Min1, Max1, Policy>& left,
+          const bounded_quantity<Q, Min2, Max2, Policy>& right) {
+  return detail::bounded_sum<Q, Min1, Max1, Policy>::template apply<
+      std::ratio_multiply<Max2, std::ratio<-1>>,
+      std::ratio_multiply<Min2, std::ratio<-1>>>(left.quantity() -
+                                                  right.quantity());
+}
+
+template <typename Q, typename Min1, typename Max1, typename Min2,
+          typename Max2, typename Policy>
+constexpr bool operator==(
+    const bounded_quantity<Q, Min1, Max1, Policy>& left,
+    const bounded_quantity<Q, Min2, Max2, Policy>& right) {
+  return left.quantity() == right.quantity();
+}
+
+template <typename Q, typename Min1, typename Max1, typename Min2,
+          typename Max2, typename Policy>
+constexpr bool operator<(const bounded_quantity<Q, Min1, Max1, Policy>& left,
+                         const bounded_quantity<Q, Min2, Max2, Policy>& right) {
+  return left.quantity() < right.quantity();
+}
+
+// Whether every quantity in a range lies within the bounds of B, excluding
+// the upper bound under wrap_bounds. Each lane accumulates without branches
+// whether one of its values failed the bounds check, which NaN values always
+// do.
+template <typename B, class InputIt>
+bool within_bounds(InputIt first, InputIt last) {
+  using value_type = typename B::value_type;
+  using Q = typename B::quantity_type;
+  constexpr std::size_t lanes = 4;
+  const value_type lower = B::lower_value();
+  const value_type upper = B::upper_value();
+  const bool closed = !std::is_same<typename B::policy, wrap_bounds>::value;
+
+  bool outside[lanes] = {};
+  while (first != last) {
+    // Lanes past the end of the range hold the lower bound
+    value_type v[lanes] = {lower, lower, lower, lower};
+    for (std::size_t i = 0; i < lanes && first != last; ++i, ++first) {
+      v[i] = Q(*first).value();
+    }
+    for (std::size_t i = 0; i < lanes; ++i) {
+      outside[i] |=
+          !((lower <= v[i]) & ((v[i] < upper) | (closed & (v[i] == upper))));
+    }
+  }
+  return !(outside[0] | outside[1] | outside[2] | outside[3]);
+}
+
+}  // namespace scalr
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_CALCULUS_HPP
+#define SCALR_CALCULUS_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "scalr/math.hpp"
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Values of a sampled series Q over timestamps T are held in floating-point
+// form in the units of Q and T
+template <typename Q, typename T>
+struct sampled_series {
+  using value_type = floating_value_t<typename std::common_type<
+      typename Q::value_type, typename T::value_type>::type>;
+  using sample_type = quantity<value_type, typename Q::unit>;
+  using time_type = quantity<value_type, typename T::unit>;
+  using integral_type = quantity_product_t<sample_type, time_type>;
+  using derivative_type =
+      quantity_product_t<sample_type, quantity_inverse_t<time_type>>;
+};
+
+constexpr std::size_t calculus_lanes = 4;
+
+}  // namespace detail
+
+/* Streaming numerical integration and differentiation
+ *
+ * Integrators and differentiators consume a series of (timestamp, sample)
+ * pairs with increasing timestamps, one sample or one chunk at a time. The
+ * last samples of a chunk are kept, so chunk boundaries do not change the
+ * result. Timestamps need not be uniformly spaced.
+ */
+
+// Integral by the trapezoidal rule, in the product of the units of Q and T
+template <typename Q, typename T>
+class trapezoid_integrator {
+  using series = detail::sampled_series<Q, T>;
+  using value_type = typename series::value_type;
+
+ public:
+  using sample_type = typename series::sample_type;
+  using time_type = typename series::time_type;
+  using result_type = typename series::integral_type;
+
+  constexpr trapezoid_integrator()
+      : count_(0), time_(0), sample_(0), sum_(0) {}
+
+  template <typename T1, typename U1, typename T2, typename U2>
+  void push(const quantity<T1, U1>& t, const quantity<T2, U2>& q) {
+    const value_type u = time_type(t).value();
+    const value_type y = sample_type(q).value();
+    if (count_ != 0) {
+      sum_ += (y + sample_) * (u - time_) / 2;
+    }
+    ++count_;
+    time_ = u;
+    sample_ = y;
+  }
+
+  // Integrates a chunk of samples. Intervals are summed over independent
+  // lanes, which breaks the dependency chain of a single running sum without
+  // reassociating floating-point additions; lanes past the end of the chunk
+  // repeat its last sample and add nothing.
+  template <class TimeIt, class SampleIt>
+  void push(TimeIt t_first, TimeIt t_last, SampleIt q_first) {
+    constexpr std::size_t lanes = detail::calculus_lanes;
+    if (t_first == t_last) {
+      return;
+    }
+    if (count_ == 0) {
+      push(*t_first++, *q_first++);
+    }
+
+    value_type partial[lanes] = {};
+    while (t_first != t_last) {
+      value_type u[lanes + 1];
+      value_type y[lanes + 1];
+      u[0] = time_;
+      y[0] = sample_;
+      for (std::size_t i = 1; i <= lanes; ++i) {
+        if (t_first != t_last) {
+          time_ = time_type(*t_first++).value();
+          sample_ = sample_type(*q_first++).value();
+          ++count_;
+        }
+        u[i] = time_;
+        y[i] = sample_;
+      }
+      for (std::size_t i = 0; i < lanes; ++i) {
+        partial[i] += (y[i + 1] + y[i]) * (u[i + 1] - u[i]);
+      }
+    }
+
+    value_type sum = 0;
+    for (std::size_t i = 0; i < lanes; ++i) {
+      sum += partial[i];
+    }
+    sum_ += sum / 2;
+  }
+
+  std::size_t count() const { return count_; }
+
+  result_type value() const { return result_type(sum_); }
+
+ private:
+  std::size_t count_;
+  value_type time_;
+  value_type sample_;
+  value_type sum_;
+};
+
+// Integral by composite Simpson's rule over pairs of intervals of any
+// lengths. A trailing unpaired interval is added by the trapezoidal rule
+// until the next sample completes its pair.
+template <typename Q, typename T>
+class simpson_integrator {
+  using series = detail::sampled_series<Q, T>;
+  using value_type = typename series::value_type;
+
+ public:
+  using sample_type = typename series::sample_type;
+  using time_type = typename series::time_type;
+  using result_type = typename series::integral_type;
+
+  constexpr simpson_integrator()
+      : count_(0), t0_(0), y0_(0), t1_(0), y1_(0), sum_(0) {}
+
+  template <typename T1, typename U1, typename T2, typename U2>
+  void push(const quantity<T1, U1>& t, const quantity<T2, U2>& q) {
+    const value_type u = time_type(t).value();
+    const value_type y = sample_type(q).value();
+    if (count_ == 0) {
+      t0_ = u;
+      y0_ = y;
+    } else if (count_ % 2 == 1) {
+      t1_ = u;
+      y1_ = y;
+    } else {
+      sum_ += panel(u, y);
+      t0_ = u;
+      y0_ = y;
+    }
+    ++count_;
+  }
+
+  template <class TimeIt, class SampleIt>
+  void push(TimeIt t_first, TimeIt t_last, SampleIt q_first) {
+    for (; t_first != t_last; ++t_first, ++q_first) {
+      push(*t_first, *q_first);
+    }
+  }
+
+  std::size_t count() const { return count_; }
+
+  result_type value() const {
+    const bool open = count_ != 0 && count_ % 2 == 0;
+    return result_type(open ? sum_ + (y1_ + y0_) * (t1_ - t0_) / 2 : sum_);
+  }
+
+ private:
+  // Simpson's rule over [t0, t2] with a midpoint t1 anywhere inside
+  value_type panel(value_type t2, value_type y2) const {
+    const value_type h0 = t1_ - t0_;
+    const value_type h1 = t2 - t1_;
+    const value_type h = h0 + h1;
+    return h / 6 *
+           ((2 - h1 / h0) * y0_ + h * h / (h0 * h1) * y1_ + (2 - h0 / h1) * y2);
+  }
+
+  std::size_t count_;
+  value_type t0_;
+  value_type y0_;
+  value_type t1_;
+  value_type y1_;
+  value_type sum_;
+};
+
+// First derivative by backward differences, one for each sample after the
+// first, taken at the timestamp of that sample
+template <typename Q, typename T>
+class backward_differentiator {
+  using series = detail::sampled_series<Q, T>;
+  using value_type = typename series::value_type;
+
+ public:
+  using sample_type = typename series::sample_type;
+  using time_type = typename series::time_type;
+  using result_type = typename series::derivative_type;
+
+  constexpr backward_differentiator() : count_(0), time_(0), sample_(0) {}
+
+  // Writes the derivatives of a chunk of samples to d_first and returns the
+  // end of the written range
+  template <class TimeIt, class SampleIt, class OutputIt>
+  OutputIt operator()(TimeIt t_first, TimeIt t_last, SampleIt q_first,
+                      OutputIt d_first) {
+    value_type time = time_;
+    value_type sample = sample_;
+    if (count_ == 0 && t_first != t_last) {
+      time = time_type(*t_first++).value();
+      sample = sample_type(*q_first++).value();
+      ++count_;
+    }
+    for (; t_first != t_last; ++t_first, ++q_first, ++d_first, ++count_) {
+      const value_type u = time_type(*t_first).value();
+      const value_type y = sample_type(*q_first).value();
+      *d_first = result_type((y - sample) / (u - time));
+      time = u;
+      sample = y;
+    }
+    time_ = time;
+    sample_ = sample;
+    return d_first;
+  }
+
+  std::size_t count() const { return count_; }
+
+ private:
+  std::size_t count_;
+  value_type time_;
+  value_type sample_;
+};
+
+// First derivative by second-order central differences over unevenly spaced
+// samples. The derivative at a sample needs the next one, so each sample
+// after the second emits the derivative at the sample before it.
+template <typename Q, typename T>
+class central_differentiator {
+  using series = detail::sampled_series<Q, T>;
+  using value_type = typename series::value_type;
+
+ public:
+  using sample_type = typename series::sample_type;
+  using time_type = typename series::time_type;
+  using result_type = typename series::derivative_type;
+
+  constexpr central_differentiator()
+      : count_(0), t0_(0), y0_(0), t1_(0), y1_(0) {}
+
+  template <class TimeIt, class SampleIt, class OutputIt>
+  OutputIt operator()(TimeIt t_first, TimeIt t_last, SampleIt q_first,
+                      OutputIt d_first) {
+    for (; t_first != t_last; ++t_first, ++q_first, ++count_) {
+      const value_type u = time_type(*t_first).value();
+      const value_type y = sample_type(*q_first).value();
+      if (count_ >= 2) {
+        const value_type h0 = t1_ - t0_;
+        const value_type h1 = u - t1_;
+        *d_first++ = result_type((h0 * h0 * (y - y1_) + h1 * h1 * (y1_ - y0_)) /
+                                 (h0 * h1 * (h0 + h1)));
+      }
+      t0_ = t1_;
+      y0_ = y1_;
+      t1_ = u;
+      y1_ = y;
+    }
+    return d_first;
+  }
+
+  std::size_t count() const { return count_; }
+
+ private:
+  std::size_t count_;
+  value_type t0_;
+  value_type y0_;
+  value_type t1_;
+  value_type y1_;
+};
+
+}  // namespace scalr
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_COMPACT_HPP
+#define SCALR_COMPACT_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include "scalr/math.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/quantity_vector.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+
+// IEEE 754 half precision storage: 1 sign, 5 exponent and 10 fraction bits
+struct float16 {
+  std::uint16_t bits;
+};
+
+// The upper half of a single precision float: 1 sign, 8 exponent and 7
+// fraction bits
+struct bfloat16 {
+  std::uint16_t bits;
+};
+
+// Quantity Q stored as Rep in steps of Step units of Q, such as
+// scaled_quantity_t<volts, std::int16_t, std::milli> in 1 mV steps
+template <typename Q, typename Rep, typename Step>
+using scaled_quantity_t =
+    quantity<Rep, make_unit_t<typename Q::dimension,
+                              std::ratio_multiply<typename Q::ratio, Step>,
+                              Q::pi>>;
+
+namespace detail {
+
+inline std::uint32_t float_bits(float f) {
+  std::uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+inline float bits_float(std::uint32_t u) {
+  float f;
+  std::memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+// Half to single precision without branches: the exponent is rebiased,
+// infinities and NaNs keep an all-ones exponent, and subnormals are
+// renormalized by a floating-point subtraction
+inline float float16_to_float(std::uint16_t h) {
+  const std::uint32_t sign = std::uint32_t(h & 0x8000u) << 16;
+  const std::uint32_t magnitude = std::uint32_t(h & 0x7fffu) << 13;
+  const std::uint32_t exponent = magnitude & 0x0f800000u;
+  const std::uint32_t normal = magnitude + 0x38000000u;
+  const std::uint32_t special = normal + 0x38000000u;
+  const std::uint32_t subnormal = float_bits(
+      bits_float(magnitude + 0x38800000u) - bits_float(0x38800000u));
+  const std::uint32_t is_special = 0u - std::uint32_t(exponent == 0x0f800000u);
+  const std::uint32_t is_subnormal = 0u - std::uint32_t(exponent == 0);
+  const std::uint32_t bits = (special & is_special) |
+                             (subnormal & is_subnormal) |
+                             (normal & ~(is_special | is_subnormal));
+  return bits_float(bits | sign);
+}
+
+// Single to half precision, rounding to nearest even. Values too large for
+// half precision become infinite and NaNs stay quiet NaNs.
+inline std::uint16_t float_to_float16(float f) {
+  const std::uint32_t u = float_bits(f);
+  const std::uint32_t sign = u & 0x80000000u;
+  const std::uint32_t magnitude = u ^ sign;
+
+  const std::uint32_t special =
+      0x7c00u | (std::uint32_t(magnitude > 0x7f800000u) << 9);
+  const std::uint32_t subnormal =
+      float_bits(bits_float(magnitude) + bits_float(0x3f000000u)) -
+      0x3f000000u;
+  const std::uint32_t normal =
+      (magnitude - 0x38000000u + 0xfffu + ((magnitude >> 13) & 1u)) >> 13;
+  const std::uint32_t is_special = 0u - std::uint32_t(magnitude >= 0x47800000u);
+  const std::uint32_t is_subnormal =
+      0u - std::uint32_t(magnitude < 0x38800000u);
+  const std::uint32_t bits = (special & is_special) |
+                             (subnormal & is_subnormal) |
+                             (normal & ~(is_special | is_subnormal));
+  return static_cast<std::uint16_t>(bits | (sign >> 16));
+}
+
+inline float bfloat16_to_float(std::uint16_t b) {
+  return bits_float(std::uint32_t(b) << 16);
+}
+
+inline std::uint16_t float_to_bfloat16(float f) {
+  const std::uint32_t u = float_bits(f);
+  const std::uint32_t rounded = (u + 0x7fffu + ((u >> 16) & 1u)) >> 16;
+  const std::uint32_t quiet = (u >> 16) | 0x0040u;
+  return static_cast<std::uint16_t>((u & 0x7fffffffu) > 0x7f800000u ? quiet
+                                                                     : rounded);
+}
+
+/* Encoding of a storage representation
+ *
+ * widen() decodes a stored value into the compute type and narrow() encodes
+ * a value of any floating-point type, rounding to nearest. representable()
+ * tells whether a value fits the range of the storage: integers saturate at
+ * their limits and store NaN as zero, and floating-point formats overflow to
+ * infinity.
+ */
+template <typename Rep, typename = void>
+struct storage_traits {
+  using compute_type = Rep;
+
+  static Rep widen(Rep s) { return s; }
+
+  template <typename T>
+  static Rep narrow(T v) {
+    return static_cast<Rep>(v);
+  }
+
+  template <typename T>
+  static bool representable(T v) {
+    return !std::isfinite(v) | std::isfinite(static_cast<Rep>(v));
+  }
+};
+
+template <typename Rep>
+struct storage_traits<
+    Rep, typename std::enable_if<std::is_integral<Rep>::value>::type> {
+  static_assert(sizeof(Rep) <= 4,
+                "compact integral storage is at most 32 bits wide");
+
+  using compute_type = double;
+
+  static constexpr double lowest() {
+    return static_cast<double>(std::numeric_limits<Rep>::lowest());
+  }
+
+  static constexpr double highest() {
+    return static_cast<double>(std::numeric_limits<Rep>::max());
+  }
+
+  static double widen(Rep s) { return static_cast<double>(s); }
+
+  template <typename T>
+  static Rep narrow(T v) {
+    const double r = std::nearbyint(static_cast<double>(v));
+    const double floor = r < lowest() ? lowest() : r;
+    const double saturated = highest() < floor ? highest() : floor;
+    return static_cast<Rep>(r == r ? saturated : 0.0);
+  }
+
+  template <typename T>
+  static bool representable(T v) {
+    const double r = std::nearbyint(static_cast<double>(v));
+    return (lowest() <= r) & (r <= highest());
+  }
+};
+
+template <>
+struct storage_traits<float16> {
+  using compute_type = float;
+
+  static float widen(float16 s) { return float16_to_float(s.bits); }
+
+  template <typename T>
+  static float16 narrow(T v) {
+    return float16{float_to_float16(static_cast<float>(v))};
+  }
+
+  template <typename T>
+  static bool representable(T v) {
+    return !std::isfinite(v) | std::isfinite(widen(narrow(v)));
+  }
+};
+
+template <>
+struct storage_traits<bfloat16> {
+  using compute_type = float;
+
+  static float widen(bfloat16 s) { return bfloat16_to_float(s.bits); }
+
+  template <typename T>
+  static bfloat16 narrow(T v) {
+    return bfloat16{float_to_bfloat16(static_cast<float>(v))};
+  }
+
+  template <typename T>
+  static bool representable(T v) {
+    return !std::isfinite(v) | std::isfinite(widen(narrow(v)));
+  }
+};
+
+}  // namespace detail
+
+/* Compact storage of quantity arrays
+ *
+ * Archives hold quantities in a narrow storage representation: float16,
+ * bfloat16, or a scaled integer whose step is part of the unit. widen()
+ * decodes them into a wider compute representation in the same unit, and
+ * narrow() encodes computed quantities into the unit and representation of
+ * the output. Both are branchless loops that compilers vectorize over
+ * contiguous arrays.
+ */
+
+// Writes stored quantities in their compute representation
+template <class InputIt, class OutputIt>
+OutputIt widen(InputIt first, InputIt last, OutputIt d_first) {
+  using S = detail::iterator_value_t<InputIt>;
+  using traits = detail::storage_traits<typename S::value_type>;
+  using C = quantity<typename traits::compute_type, typename S::unit>;
+  for (; first != last; ++first, ++d_first) {
+    *d_first = C(traits::widen((*first).value()));
+  }
+  return d_first;
+}
+
+// Stores quantities in the representation of the output, whose elements must
+// be quantities. Returns the end of the output and the number of values
+// outside the range of the storage.
+template <class InputIt, class OutputIt>
+std::pair<OutputIt, std::size_t> narrow(InputIt first, InputIt last,
+                                        OutputIt d_first) {
+  using Q = detail::iterator_value_t<InputIt>;
+  using S = detail::iterator_value_t<OutputIt>;
+  using traits = detail::storage_traits<typename S::value_type>;
+  using T = detail::floating_value_t<typename Q::value_type>;
+  using source_type = quantity<T, typename S::unit>;
+  std::size_t out_of_range = 0;
+  for (; first != last; ++first, ++d_first) {
+    const T v = source_type(*first).value();
+    *d_first = S(traits::narrow(v));
+    out_of_range += !traits::representable(v);
+  }
+  return std::pair<OutputIt, std::size_t>(d_first, out_of_range);
+}
+
+}  // namespace scalr
+
+#endif
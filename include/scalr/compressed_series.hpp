@@ -0,0 +1,363 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_COMPRESSED_SERIES_HPP
+#define SCALR_COMPRESSED_SERIES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "scalr/bits.hpp"
+#include "scalr/named_quantity/time.hpp"
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Signed integers interleaved so that small magnitudes have short varints
+inline std::uint64_t zigzag_encode(std::uint64_t value) {
+  return (value << 1) ^ (0u - (value >> 63));
+}
+
+inline std::uint64_t zigzag_decode(std::uint64_t value) {
+  return (value >> 1) ^ (0u - (value & 1));
+}
+
+// Bits appended most significant first
+struct bit_stream {
+  std::vector<std::uint8_t> bytes;
+  std::size_t size = 0;
+
+  void put(std::uint64_t value, unsigned n) {
+    while (n > 0) {
+      const unsigned offset = static_cast<unsigned>(size % 8);
+      if (offset == 0) {
+        bytes.push_back(0);
+      }
+      const unsigned room = 8 - offset;
+      const unsigned take = n < room ? n : room;
+      const unsigned chunk =
+          static_cast<unsigned>(value >> (n - take)) & ((1u << take) - 1);
+      bytes.back() |= static_cast<std::uint8_t>(chunk << (room - take));
+      n -= take;
+      size += take;
+    }
+  }
+
+  void put_varint(std::uint64_t value) {
+    detail::put_varint(bytes, value);
+    size = bytes.size() * 8;
+  }
+};
+
+class bit_cursor {
+ public:
+  explicit bit_cursor(const bit_stream& stream)
+      : data_(stream.bytes.data()), end_(data_ + stream.bytes.size()) {}
+
+  std::uint64_t get(unsigned n) {
+    std::uint64_t value = 0;
+    while (n > 0) {
+      const unsigned offset = static_cast<unsigned>(position_ % 8);
+      const unsigned room = 8 - offset;
+      const unsigned take = n < room ? n : room;
+      const unsigned byte = data_[position_ / 8];
+      value = (value << take) | ((byte >> (room - take)) & ((1u << take) - 1));
+      n -= take;
+      position_ += take;
+    }
+    return value;
+  }
+
+  std::uint64_t get_varint() {
+    const std::uint8_t* first = data_ + position_ / 8;
+    std::uint64_t value = 0;
+    detail::get_varint(first, end_, value);
+    position_ = static_cast<std::size_t>(first - data_) * 8;
+    return value;
+  }
+
+ private:
+  const std::uint8_t* data_;
+  const std::uint8_t* end_;
+  std::size_t position_ = 0;
+};
+
+/* Encoding of the samples of a block after the first one
+ *
+ * Integers are stored as zigzag varints of their differences of the given
+ * order: Order 1 for values and 2 (delta of delta) for timestamps, which
+ * take a byte each when sampled regularly. Floating-point numbers are XORed
+ * with their predecessor and only the bits in between the leading and
+ * trailing zeros of the result are kept, reusing the previous window when it
+ * covers them, as in the Gorilla time series database.
+ */
+template <typename Rep, unsigned Order,
+          bool = std::is_integral<Rep>::value>
+struct series_codec {
+  class encoder {
+   public:
+    void reset(Rep first) {
+      last_ = static_cast<std::uint64_t>(first);
+      delta_ = 0;
+    }
+
+    void put(bit_stream& out, Rep value) {
+      const std::uint64_t delta = static_cast<std::uint64_t>(value) - last_;
+      out.put_varint(zigzag_encode(Order == 1 ? delta : delta - delta_));
+      last_ += delta;
+      delta_ = delta;
+    }
+
+   private:
+    std::uint64_t last_ = 0;
+    std::uint64_t delta_ = 0;
+  };
+
+  class decoder {
+   public:
+    decoder(Rep first, const bit_stream& in)
+        : in_(in), last_(static_cast<std::uint64_t>(first)) {}
+
+    Rep next() {
+      const std::uint64_t difference = zigzag_decode(in_.get_varint());
+      delta_ = Order == 1 ? difference : difference + delta_;
+      last_ += delta_;
+      return static_cast<Rep>(last_);
+    }
+
+   private:
+    bit_cursor in_;
+    std::uint64_t last_;
+    std::uint64_t delta_ = 0;
+  };
+};
+
+template <typename Rep, unsigned Order>
+struct series_codec<Rep, Order, false> {
+  using word = typename std::conditional<sizeof(Rep) == 4, std::uint32_t,
+                                         std::uint64_t>::type;
+  static_assert(sizeof(Rep) == sizeof(word),
+                "XOR encoding requires 32 or 64-bit floating-point values");
+
+  static constexpr unsigned word_bits = 8 * sizeof(word);
+
+  static word to_word(Rep value) {
+    word w;
+    std::memcpy(&w, &value, sizeof(w));
+    return w;
+  }
+
+  static Rep from_word(word w) {
+    Rep value;
+    std::memcpy(&value, &w, sizeof(value));
+    return value;
+  }
+
+  class encoder {
+   public:
+    void reset(Rep first) {
+      last_ = to_word(first);
+      window_ = false;
+    }
+
+    void put(bit_stream& out, Rep value) {
+      const word w = to_word(value);
+      const word x = w ^ last_;
+      last_ = w;
+      if (x == 0) {
+        out.put(0, 1);
+        return;
+      }
+      const unsigned high = highest_bit(x);
+      const unsigned leading = std::min(word_bits - 1 - high, 31u);
+      const unsigned trailing = lowest_bit(x);
+      if (window_ && leading >= leading_ && trailing >= trailing_) {
+        out.put(2, 2);
+        out.put(x >> trailing_, word_bits - leading_ - trailing_);
+        return;
+      }
+      window_ = true;
+      leading_ = leading;
+      trailing_ = trailing;
+      const unsigned length = word_bits - leading - trailing;
+      out.put(3, 2);
+      out.put(leading, 5);
+      out.put(length - 1, 6);
+      out.put(x >> trailing, length);
+    }
+
+   private:
+    word last_ = 0;
+    bool window_ = false;
+    unsigned leading_ = 0;
+    unsigned trailing_ = 0;
+  };
+
+  class decoder {
+   public:
+    decoder(Rep first, const bit_stream& in)
+        : in_(in), last_(to_word(first)) {}
+
+    Rep next() {
+      if (in_.get(1) != 0) {
+        if (in_.get(1) != 0) {
+          leading_ = static_cast<unsigned>(in_.get(5));
+          trailing_ =
+              word_bits - leading_ - static_cast<unsigned>(in_.get(6) + 1);
+        }
+        const unsigned length = word_bits - leading_ - trailing_;
+        last_ ^= static_cast<word>(in_.get(length) << trailing_);
+      }
+      return from_word(last_);
+    }
+
+   private:
+    bit_cursor in_;
+    word last_;
+    unsigned leading_ = 0;
+    unsigned trailing_ = 0;
+  };
+};
+
+template <typename Rep, unsigned Order>
+constexpr unsigned series_codec<Rep, Order, false>::word_bits;
+
+}  // namespace detail
+
+/* Class template compressed time series
+ *
+ * An append-only series of (timestamp, quantity) samples, split into blocks
+ * of BlockSize samples that are encoded independently. A block keeps its
+ * first sample uncompressed and encodes the others with series_codec: delta
+ * of delta timestamps, and value deltas or XORs. The unit is part of the
+ * type and all samples are stored in it. Blocks are decoded whole, by index,
+ * and find_block() locates the block of a timestamp when timestamps are
+ * sorted.
+ */
+template <typename Q, typename Timestamp = nanoseconds,
+          std::size_t BlockSize = 1024>
+class compressed_series {
+  static_assert(BlockSize > 0, "blocks must hold at least one sample");
+
+  using time_rep = typename Timestamp::value_type;
+  using value_rep = typename Q::value_type;
+  using time_codec = detail::series_codec<time_rep, 2>;
+  using value_codec = detail::series_codec<value_rep, 1>;
+
+ public:
+  using quantity_type = Q;
+  using timestamp_type = Timestamp;
+  static constexpr std::size_t block_size = BlockSize;
+
+  void push_back(const Timestamp& t, const Q& q) {
+    if (size_ % BlockSize == 0) {
+      if (!blocks_.empty()) {
+        blocks_.back().times.bytes.shrink_to_fit();
+        blocks_.back().values.bytes.shrink_to_fit();
+      }
+      blocks_.emplace_back(t.value(), q.value());
+      time_encoder_.reset(t.value());
+      value_encoder_.reset(q.value());
+    } else {
+      time_encoder_.put(blocks_.back().times, t.value());
+      value_encoder_.put(blocks_.back().values, q.value());
+    }
+    ++size_;
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t block_count() const { return blocks_.size(); }
+
+  // Number of samples in block b
+  std::size_t block_length(std::size_t b) const {
+    return b + 1 < blocks_.size() ? BlockSize : size_ - b * BlockSize;
+  }
+
+  // First timestamp of block b
+  Timestamp block_time(std::size_t b) const {
+    return Timestamp(blocks_[b].first_time);
+  }
+
+  // The last block starting at or before t, or the first block if none does
+  std::size_t find_block(const Timestamp& t) const {
+    const auto it = std::upper_bound(
+        blocks_.begin(), blocks_.end(), t.value(),
+        [](time_rep value, const block& b) { return value < b.first_time; });
+    return it == blocks_.begin()
+               ? 0
+               : static_cast<std::size_t>(it - blocks_.begin()) - 1;
+  }
+
+  // Writes the timestamps and quantities of block b
+  template <class TimeIt, class ValueIt>
+  std::pair<TimeIt, ValueIt> decode_block(std::size_t b, TimeIt t_first,
+                                          ValueIt q_first) const {
+    const block& blk = blocks_[b];
+    typename time_codec::decoder times(blk.first_time, blk.times);
+    typename value_codec::decoder values(blk.first_value, blk.values);
+    *t_first = Timestamp(blk.first_time);
+    *q_first = Q(blk.first_value);
+    ++t_first;
+    ++q_first;
+    const std::size_t n = block_length(b);
+    for (std::size_t i = 1; i < n; ++i, ++t_first, ++q_first) {
+      *t_first = Timestamp(times.next());
+      *q_first = Q(values.next());
+    }
+    return std::pair<TimeIt, ValueIt>(t_first, q_first);
+  }
+
+  // Writes all timestamps and quantities
+  template <class TimeIt, class ValueIt>
+  std::pair<TimeIt, ValueIt> decode(TimeIt t_first, ValueIt q_first) const {
+    std::pair<TimeIt, ValueIt> out(t_first, q_first);
+    for (std::size_t b = 0; b < blocks_.size(); ++b) {
+      out = decode_block(b, out.first, out.second);
+    }
+    return out;
+  }
+
+  // Bytes held by the encoded samples and the block headers
+  std::size_t compressed_bytes() const {
+    std::size_t bytes = blocks_.size() * sizeof(block);
+    for (const block& b : blocks_) {
+      bytes += b.times.bytes.size() + b.values.bytes.size();
+    }
+    return bytes;
+  }
+
+ private:
+  struct block {
+    block(time_rep t, value_rep q) : first_time(t), first_value(q) {}
+
+    time_rep first_time;
+    value_rep first_value;
+    detail::bit_stream times;
+    detail::bit_stream values;
+  };
+
+  std::vector<block> blocks_;
+  std::size_t size_ = 0;
+  typename time_codec::encoder time_encoder_;
+  typename value_codec::encoder value_encoder_;
+};
+
+template <typename Q, typename Timestamp, std::size_t BlockSize>
+constexpr std::size_t compressed_series<Q, Timestamp, BlockSize>::block_size;
+
+}  // namespace scalr
+
+#endif
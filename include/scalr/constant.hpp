@@ -0,0 +1,363 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_CONSTANT_HPP
+#define SCALR_CONSTANT_HPP
+
+#include <ratio>
+#include <type_traits>
+
+#include "scalr/dimension.hpp"
+#include "scalr/named_quantity/acceleration.hpp"
+#include "scalr/named_quantity/amount_of_substance.hpp"
+#include "scalr/named_quantity/angle.hpp"
+#include "scalr/named_quantity/angular_acceleration.hpp"
+#include "scalr/named_quantity/angular_length.hpp"
+#include "scalr/named_quantity/angular_momentum.hpp"
+#include "scalr/named_quantity/angular_speed.hpp"
+#include "scalr/named_quantity/area.hpp"
+#include "scalr/named_quantity/crackle.hpp"
+#include "scalr/named_quantity/electric_current.hpp"
+#include "scalr/named_quantity/electric_potential.hpp"
+#include "scalr/named_quantity/energy.hpp"
+#include "scalr/named_quantity/force.hpp"
+#include "scalr/named_quantity/frequency.hpp"
+#include "scalr/named_quantity/jerk.hpp"
+#include "scalr/named_quantity/length.hpp"
+#include "scalr/named_quantity/luminous_intensity.hpp"
+#include "scalr/named_quantity/mass.hpp"
+#include "scalr/named_quantity/moment_of_inertia.hpp"
+#include "scalr/named_quantity/pop.hpp"
+#include "scalr/named_quantity/power.hpp"
+#include "scalr/named_quantity/snap.hpp"
+#include "scalr/named_quantity/solid_angle.hpp"
+#include "scalr/named_quantity/speed.hpp"
+#include "scalr/named_quantity/temperature.hpp"
+#include "scalr/named_quantity/time.hpp"
+#include "scalr/named_quantity/volume.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+
+// Decimal constant values Mantissa * 10^Exponent
+template <intmax_t Mantissa, int Exponent>
+struct decimal {
+  static constexpr long double value() {
+    return Exponent < 0 ? Mantissa / power(-Exponent)
+                        : Mantissa * power(Exponent);
+  }
+
+ private:
+  static constexpr long double power(int k) {
+    return k == 0 ? 1.0L : 10.0L * power(k - 1);
+  }
+};
+
+/* Class template physical constant type
+ *
+ * The value of a constant is either a std::ratio, a scalr::decimal, or a
+ * type with a static constexpr value() function for irrational values. Exact
+ * values are folded into the unit ratio of the result when multiplying or
+ * dividing quantities so that no runtime operation is needed. Otherwise the
+ * value is applied as a single multiply.
+ */
+template <typename Value, typename Unit>
+struct constant {
+  using value_type = Value;
+  using dimension = typename Unit::dimension;
+  using ratio = typename Unit::ratio;
+  static constexpr intmax_t pi = detail::unit_pi<Unit>::value;
+  using unit = make_unit_t<dimension, ratio, pi>;
+
+  static_assert(detail::is_unit_type<unit>::value,
+                "constant unit must be a physical unit");
+
+  template <typename Rep, typename Unit2,
+            typename std::enable_if<
+                std::is_same<typename Unit2::dimension, dimension>::value &&
+                    std::is_floating_point<Rep>::value,
+                int>::type = 0>
+  constexpr operator quantity<Rep, Unit2>() const {
+    return quantity_cast<quantity<Rep, Unit2>>(
+        quantity<long double, unit>(value()));
+  }
+
+  static constexpr long double value();
+};
+
+namespace detail {
+
+constexpr bool wide_pow10_fits(int k, wide_int acc = 1) {
+  return k == 0                      ? true
+         : acc > wide_max() / 10     ? false
+                                     : wide_pow10_fits(k - 1, acc * 10);
+}
+
+constexpr wide_int wide_pow10(int k) {
+  return k == 0 ? 1 : 10 * wide_pow10(k - 1);
+}
+
+// The exact rational value of a constant if it fits in wide arithmetic
+template <typename Value>
+struct exact_value : std::false_type {};
+
+template <intmax_t Num, intmax_t Den>
+struct exact_value<std::ratio<Num, Den>> : std::true_type {
+  using type = wide_ratio<Num, Den>;
+};
+
+template <intmax_t Mantissa, int Exponent, bool = (Exponent < 0)>
+struct decimal_fits
+    : bool_constant<wide_pow10_fits(Exponent) &&
+                    wide_multiply_fits(Mantissa, wide_pow10(Exponent))> {};
+
+template <intmax_t Mantissa, int Exponent>
+struct decimal_fits<Mantissa, Exponent, true>
+    : bool_constant<wide_pow10_fits(-Exponent)> {};
+
+template <intmax_t Mantissa, int Exponent,
+          bool = decimal_fits<Mantissa, Exponent>::value,
+          bool = (Exponent < 0)>
+struct decimal_ratio : std::false_type {};
+
+template <intmax_t Mantissa, int Exponent>
+struct decimal_ratio<Mantissa, Exponent, true, false> : std::true_type {
+  using type = wide_ratio<Mantissa * wide_pow10(Exponent)>;
+};
+
+template <intmax_t Mantissa, int Exponent>
+struct decimal_ratio<Mantissa, Exponent, true, true> : std::true_type {
+  using type = wide_ratio<Mantissa, wide_pow10(-Exponent)>;
+};
+
+template <intmax_t Mantissa, int Exponent>
+struct exact_value<decimal<Mantissa, Exponent>>
+    : decimal_ratio<Mantissa, Exponent> {};
+
+template <typename Value>
+struct constant_value {
+  static constexpr long double get() { return Value::value(); }
+};
+
+template <intmax_t Num, intmax_t Den>
+struct constant_value<std::ratio<Num, Den>> {
+  static constexpr long double get() {
+    return static_cast<long double>(Num) / Den;
+  }
+};
+
+// Folding a constant C into a quantity ratio R: R * C (or R / C) must fit in
+// a std::ratio after all. Each step reports failure instead of overflowing.
+template <typename R, bool = wide_ratio_fits<R>::value>
+struct constant_fold_narrow : std::false_type {};
+
+template <typename R>
+struct constant_fold_narrow<R, true> : std::true_type {
+  using ratio = wide_ratio_narrow_t<R>;
+};
+
+template <typename Product, bool = Product::value>
+struct constant_fold_check : std::false_type {};
+
+template <typename Product>
+struct constant_fold_check<Product, true>
+    : constant_fold_narrow<typename Product::type> {};
+
+template <typename Ratio, typename Scaled, bool Inverse,
+          bool = Scaled::value>
+struct constant_fold_scaled : std::false_type {};
+
+template <typename Ratio, typename Scaled, bool Inverse>
+struct constant_fold_scaled<Ratio, Scaled, Inverse, true>
+    : constant_fold_check<wide_ratio_try_multiply<
+          Ratio, typename std::conditional<
+                     Inverse,
+                     wide_ratio<Scaled::type::den, Scaled::type::num>,
+                     typename Scaled::type>::type>> {};
+
+template <typename Ratio, typename C, bool Inverse,
+          bool = exact_value<typename C::value_type>::value>
+struct constant_fold : std::false_type {};
+
+template <typename Ratio, typename C, bool Inverse>
+struct constant_fold<Ratio, C, Inverse, true>
+    : constant_fold_scaled<
+          Ratio,
+          wide_ratio_try_multiply<
+              typename C::ratio,
+              typename exact_value<typename C::value_type>::type>,
+          Inverse> {};
+
+template <typename Q, typename C, bool Inverse,
+          bool = constant_fold<typename Q::ratio, C, Inverse>::value>
+struct constant_product {
+  using V = typename std::common_type<typename Q::value_type, double>::type;
+  using U = typename std::conditional<Inverse, unit_inverse_t<typename C::unit>,
+                                      typename C::unit>::type;
+  using type = quantity<V, unit_product_t<typename Q::unit, U>>;
+
+  static constexpr type apply(const Q& q) {
+    return type(Inverse ? static_cast<V>(q.value()) /
+                              static_cast<V>(
+                                  constant_value<typename C::value_type>::get())
+                        : static_cast<V>(q.value()) *
+                              static_cast<V>(
+                                  constant_value<
+                                      typename C::value_type>::get()));
+  }
+};
+
+template <typename Q, typename C, bool Inverse>
+struct constant_product<Q, C, Inverse, true> {
+  using D = typename std::conditional<
+      Inverse, dimension_inverse_t<typename C::dimension>,
+      typename C::dimension>::type;
+  using type = quantity<
+      typename Q::value_type,
+      make_unit_t<dimension_product_t<typename Q::dimension, D>,
+                  typename constant_fold<typename Q::ratio, C,
+                                         Inverse>::ratio,
+                  Q::pi + (Inverse ? -C::pi : C::pi)>>;
+
+  static constexpr type apply(const Q& q) { return type(q.value()); }
+};
+
+}  // namespace detail
+
+template <typename Value, typename Unit>
+constexpr intmax_t constant<Value, Unit>::pi;
+
+template <typename Value, typename Unit>
+constexpr long double constant<Value, Unit>::value() {
+  return detail::constant_value<Value>::get();
+}
+
+// The multiplication by a constant
+template <typename Rep, typename Unit, typename Value, typename Unit2>
+constexpr typename detail::constant_product<quantity<Rep, Unit>,
+                                            constant<Value, Unit2>,
+                                            false>::type
+operator*(const quantity<Rep, Unit>& left, const constant<Value, Unit2>&) {
+  return detail::constant_product<quantity<Rep, Unit>, constant<Value, Unit2>,
+                                  false>::apply(left);
+}
+
+template <typename Rep, typename Unit, typename Value, typename Unit2>
+constexpr typename detail::constant_product<quantity<Rep, Unit>,
+                                            constant<Value, Unit2>,
+                                            false>::type
+operator*(const constant<Value, Unit2>&, const quantity<Rep, Unit>& right) {
+  return detail::constant_product<quantity<Rep, Unit>, constant<Value, Unit2>,
+                                  false>::apply(right);
+}
+
+// The division by a constant
+template <typename Rep, typename Unit, typename Value, typename Unit2>
+constexpr typename detail::constant_product<quantity<Rep, Unit>,
+                                            constant<Value, Unit2>,
+                                            true>::type
+operator/(const quantity<Rep, Unit>& left, const constant<Value, Unit2>&) {
+  return detail::constant_product<quantity<Rep, Unit>, constant<Value, Unit2>,
+                                  true>::apply(left);
+}
+
+namespace detail {
+
+// Dimensions of constants that have no named quantity
+using electric_charge_dimension =
+    dimension_product_t<electric_current_dimension, time_dimension>;
+using pressure_dimension =
+    dimension_product_t<force_dimension,
+                        dimension_exponent_t<length_dimension, -2>>;
+
+}  // namespace detail
+
+// CODATA 2018 recommended values of fundamental physical constants
+// Constant units are derived from the named dimensions, all of which must be
+// declared beforehand.
+namespace constants {
+
+// Exact by the definition of SI units
+using speed_of_light_t =
+    constant<std::ratio<299792458>, make_unit_t<speed_dimension>>;
+using caesium_frequency_t =
+    constant<std::ratio<9192631770>, make_unit_t<frequency_dimension>>;
+using planck_t =
+    constant<decimal<662607015, -42>,
+             make_unit_t<dimension_product_t<energy_dimension,
+                                             time_dimension>>>;
+using elementary_charge_t =
+    constant<decimal<1602176634, -28>,
+             make_unit_t<detail::electric_charge_dimension>>;
+using boltzmann_t = constant<
+    decimal<1380649, -29>,
+    make_unit_t<dimension_product_t<energy_dimension,
+                                    dimension_inverse_t<
+                                        temperature_dimension>>>>;
+using avogadro_t =
+    constant<decimal<602214076, 15>,
+             make_unit_t<dimension_inverse_t<amount_of_substance_dimension>>>;
+
+// Exact as products of exact constants
+using molar_gas_t = constant<
+    decimal<831446261815324, -14>,
+    make_unit_t<dimension_product_t<
+        energy_dimension,
+        dimension_inverse_t<temperature_dimension>,
+        dimension_inverse_t<amount_of_substance_dimension>>>>;
+using faraday_t = constant<
+    decimal<964853321233100184, -13>,
+    make_unit_t<dimension_product_t<
+        detail::electric_charge_dimension,
+        dimension_inverse_t<amount_of_substance_dimension>>>>;
+
+// Exact by convention
+using standard_gravity_t =
+    constant<std::ratio<980665, 100000>, make_unit_t<acceleration_dimension>>;
+using standard_atmosphere_t =
+    constant<std::ratio<101325>, make_unit_t<detail::pressure_dimension>>;
+
+// Measured
+using gravitational_t = constant<
+    decimal<667430, -16>,
+    make_unit_t<dimension_product_t<
+        dimension_exponent_t<length_dimension, 3>,
+        dimension_inverse_t<mass_dimension>,
+        dimension_exponent_t<time_dimension, -2>>>>;
+using electron_mass_t =
+    constant<decimal<91093837015, -41>, make_unit_t<mass_dimension>>;
+using proton_mass_t =
+    constant<decimal<167262192369, -38>, make_unit_t<mass_dimension>>;
+using vacuum_permeability_t = constant<
+    decimal<125663706212, -17>,
+    make_unit_t<dimension_product_t<
+        force_dimension,
+        dimension_exponent_t<electric_current_dimension, -2>>>>;
+
+constexpr speed_of_light_t speed_of_light{};
+constexpr caesium_frequency_t caesium_frequency{};
+constexpr planck_t planck{};
+constexpr elementary_charge_t elementary_charge{};
+constexpr boltzmann_t boltzmann{};
+constexpr avogadro_t avogadro{};
+constexpr molar_gas_t molar_gas{};
+constexpr faraday_t faraday{};
+constexpr standard_gravity_t standard_gravity{};
+constexpr standard_atmosphere_t standard_atmosphere{};
+constexpr gravitational_t gravitational{};
+constexpr electron_mass_t electron_mass{};
+constexpr proton_mass_t proton_mass{};
+constexpr vacuum_permeability_t vacuum_permeability{};
+
+}  // namespace constants
+
+}  // namespace scalr
+
+#endif
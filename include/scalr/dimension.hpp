@@ -104,6 +104,20 @@ struct exponent {
                              k * U::n, k * U::j, k * U::r>::type;
 };
 
+// Dimension arithmetic has integer exponents only, so a root exists when every
+// exponent is divisible by the degree
+template <class D, intmax_t k>
+struct root {
+  using U = typename D::signature;
+  static_assert(k > 0, "root degree must be positive");
+  static_assert(U::t % k == 0 && U::l % k == 0 && U::m % k == 0 &&
+                    U::i % k == 0 && U::k % k == 0 && U::n % k == 0 &&
+                    U::j % k == 0 && U::r % k == 0,
+                "dimension exponents must be divisible by the root degree");
+  using type = typename make<U::t / k, U::l / k, U::m / k, U::i / k, U::k / k,
+                             U::n / k, U::j / k, U::r / k>::type;
+};
+
 }  // namespace dimension
 
 // Helper traits
@@ -119,6 +133,9 @@ using dimension_inverse_t = typename dimension::exponent<D, -1>::type;
 template <class D, intmax_t k>
 using dimension_exponent_t = typename dimension::exponent<D, k>::type;
 
+template <class D, intmax_t k>
+using dimension_root_t = typename dimension::root<D, k>::type;
+
 template <class D1, class D2>
 using dimension_equal = typename dimension::equal<D1, D2>;
 
@@ -0,0 +1,159 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_DIVIDER_HPP
+#define SCALR_DIVIDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace scalr {
+
+// Rounding modes of integral unit conversions
+enum class rounding { toward_zero, downward, upward, to_nearest };
+
+namespace detail {
+
+template <std::size_t Bytes>
+struct uint_of_size {};
+
+template <>
+struct uint_of_size<1> {
+  using type = std::uint8_t;
+};
+
+template <>
+struct uint_of_size<2> {
+  using type = std::uint16_t;
+};
+
+template <>
+struct uint_of_size<4> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct uint_of_size<8> {
+  using type = std::uint64_t;
+};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128_t;
+
+template <>
+struct uint_of_size<16> {
+  using type = uint128_t;
+};
+#endif
+
+constexpr unsigned floor_log2(uintmax_t x) {
+  return x <= 1 ? 0 : 1 + floor_log2(x >> 1);
+}
+
+constexpr unsigned ceil_log2(uintmax_t x) {
+  return x <= 1 ? 0 : 1 + floor_log2(x - 1);
+}
+
+// Division by a compile-time constant D using a multiply-high and shifts
+// instead of a hardware divide (Granlund & Montgomery, 1994). The multiplier
+// is computed in twice the width of UInt so that the quotient is exact for
+// every value of UInt. Widths without a twice-as-wide type fall back to the
+// divide instruction.
+template <typename UInt, uintmax_t D, typename Enable = void>
+struct unsigned_divider {
+  static constexpr UInt quotient(UInt n) { return static_cast<UInt>(n / D); }
+};
+
+template <typename UInt, uintmax_t D>
+struct unsigned_divider<
+    UInt, D,
+    typename std::enable_if<
+        (D > 1) && (D <= std::numeric_limits<UInt>::max()) &&
+        std::is_unsigned<
+            typename uint_of_size<2 * sizeof(UInt)>::type>::value>::type> {
+  using wide_type = typename uint_of_size<2 * sizeof(UInt)>::type;
+
+  static constexpr unsigned width = std::numeric_limits<UInt>::digits;
+  static constexpr unsigned shift = ceil_log2(D);
+
+  static constexpr UInt multiplier() {
+    return static_cast<UInt>(
+        ((wide_type(1) << width) * ((wide_type(1) << shift) - D)) / D + 1);
+  }
+
+  static constexpr UInt quotient(UInt n) {
+    return quotient(n, static_cast<UInt>((wide_type(multiplier()) * n) >>
+                                         width));
+  }
+
+ private:
+  static constexpr UInt quotient(UInt n, UInt t) {
+    return static_cast<UInt>((t + static_cast<UInt>((n - t) >> 1)) >>
+                             (shift - 1));
+  }
+};
+
+// Divisors beyond the range of UInt yield zero for every value
+template <typename UInt, uintmax_t D>
+struct unsigned_divider<
+    UInt, D,
+    typename std::enable_if<(D > std::numeric_limits<UInt>::max())>::type> {
+  static constexpr UInt quotient(UInt) { return 0; }
+};
+
+// Rounded division of an integral value by a positive constant D
+template <typename T, uintmax_t D>
+struct constant_divider {
+  static_assert(std::is_integral<T>::value, "divider requires integral type");
+  static_assert(D > 0, "division by zero");
+
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  using impl = unsigned_divider<unsigned_type, D>;
+
+  static constexpr T divide(T n, rounding mode = rounding::toward_zero) {
+    return apply(n, magnitude(n), impl::quotient(magnitude(n)), mode);
+  }
+
+ private:
+  static constexpr unsigned_type magnitude(T n) {
+    return n < 0 ? static_cast<unsigned_type>(unsigned_type(0) -
+                                              static_cast<unsigned_type>(n))
+                 : static_cast<unsigned_type>(n);
+  }
+
+  static constexpr unsigned_type increment(unsigned_type q, unsigned_type r,
+                                           bool negative, rounding mode) {
+    return mode == rounding::toward_zero ? 0
+           : mode == rounding::downward  ? (negative && r != 0)
+           : mode == rounding::upward    ? (!negative && r != 0)
+           : (r > D - r) ? 1
+           : (r == D - r) ? (q & 1)
+                          : 0;
+  }
+
+  static constexpr T apply(T n, unsigned_type u, unsigned_type q,
+                           rounding mode) {
+    return signed_quotient(
+        n < 0,
+        static_cast<unsigned_type>(
+            q + increment(q, static_cast<unsigned_type>(u - q * D), n < 0,
+                          mode)));
+  }
+
+  static constexpr T signed_quotient(bool negative, unsigned_type q) {
+    return negative ? static_cast<T>(unsigned_type(0) - q) : static_cast<T>(q);
+  }
+};
+
+}  // namespace detail
+}  // namespace scalr
+
+#endif
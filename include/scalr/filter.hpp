@@ -0,0 +1,269 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_FILTER_HPP
+#define SCALR_FILTER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "scalr/quantity.hpp"
+#include "scalr/quantity_vector.hpp"
+
+namespace scalr {
+
+// How the elements of an array are compared with a threshold
+enum class comparison {
+  less,
+  less_equal,
+  greater,
+  greater_equal,
+  equal,
+  not_equal
+};
+
+namespace detail {
+
+/* Closed interval of the values of an array of quantity Q
+ *
+ * Thresholds in any unit of the dimension of Q are converted into the unit
+ * of Q once, before a kernel runs, so elements are compared as plain values.
+ * Floating-point arrays replace strict bounds with the adjacent representable
+ * value. Integral arrays round bounds to the integers they separate, in
+ * extended precision, and an interval without integers has lo > hi.
+ */
+template <typename Q,
+          bool = std::is_floating_point<typename Q::value_type>::value>
+struct value_interval {
+  using value_type = typename Q::value_type;
+
+  static constexpr value_type infinity() {
+    return std::numeric_limits<value_type>::infinity();
+  }
+
+  value_type lo = -infinity();
+  value_type hi = infinity();
+
+  template <typename Rep, typename Unit>
+  void above(const quantity<Rep, Unit>& threshold, bool strict) {
+    const value_type t = quantity_cast<Q>(threshold).value();
+    lo = strict ? std::nextafter(t, infinity()) : t;
+  }
+
+  template <typename Rep, typename Unit>
+  void below(const quantity<Rep, Unit>& threshold, bool strict) {
+    const value_type t = quantity_cast<Q>(threshold).value();
+    hi = strict ? std::nextafter(t, -infinity()) : t;
+  }
+
+  value_type lower() const { return lo; }
+  value_type upper() const { return hi; }
+};
+
+template <typename Q>
+struct value_interval<Q, false> {
+  using value_type = typename Q::value_type;
+  using wide_type = quantity<long double, typename Q::unit>;
+
+  long double lo = std::numeric_limits<value_type>::lowest();
+  long double hi = std::numeric_limits<value_type>::max();
+
+  template <typename Rep, typename Unit>
+  void above(const quantity<Rep, Unit>& threshold, bool strict) {
+    const long double t = quantity_cast<wide_type>(threshold).value();
+    const long double bound = strict ? std::floor(t) + 1 : std::ceil(t);
+    lo = bound < lo ? lo : bound;
+  }
+
+  template <typename Rep, typename Unit>
+  void below(const quantity<Rep, Unit>& threshold, bool strict) {
+    const long double t = quantity_cast<wide_type>(threshold).value();
+    const long double bound = strict ? std::ceil(t) - 1 : std::floor(t);
+    hi = hi < bound ? hi : bound;
+  }
+
+  value_type lower() const {
+    return hi < lo ? value_type(1) : static_cast<value_type>(lo);
+  }
+
+  value_type upper() const {
+    return hi < lo ? value_type(0) : static_cast<value_type>(hi);
+  }
+};
+
+// The interval selected by a comparison; not_equal selects its complement
+template <typename Q, typename Rep, typename Unit>
+value_interval<Q> comparison_interval(comparison op,
+                                      const quantity<Rep, Unit>& threshold) {
+  value_interval<Q> interval;
+  switch (op) {
+    case comparison::less:
+      interval.below(threshold, true);
+      break;
+    case comparison::less_equal:
+      interval.below(threshold, false);
+      break;
+    case comparison::greater:
+      interval.above(threshold, true);
+      break;
+    case comparison::greater_equal:
+      interval.above(threshold, false);
+      break;
+    case comparison::equal:
+    case comparison::not_equal:
+      interval.above(threshold, false);
+      interval.below(threshold, false);
+      break;
+  }
+  return interval;
+}
+
+}  // namespace detail
+
+/* Threshold kernels over arrays of quantities
+ *
+ * Each kernel converts its thresholds into the unit of the array once and
+ * then runs a branchless loop over plain values, instead of converting every
+ * element through the mixed-unit comparison operators. Loops over contiguous
+ * arrays vectorize; select() writes a variable number of elements and stays
+ * scalar.
+ */
+
+// Writes whether each element compares true with the threshold
+template <class InputIt, class OutputIt, typename Rep, typename Unit>
+OutputIt compare(InputIt first, InputIt last, OutputIt d_first, comparison op,
+                 const quantity<Rep, Unit>& threshold) {
+  using Q = detail::iterator_value_t<InputIt>;
+  using T = typename Q::value_type;
+  const auto interval = detail::comparison_interval<Q>(op, threshold);
+  const T lo = interval.lower();
+  const T hi = interval.upper();
+  const bool inverted = op == comparison::not_equal;
+  for (; first != last; ++first, ++d_first) {
+    const T x = Q(*first).value();
+    *d_first = ((lo <= x) & (x <= hi)) != inverted;
+  }
+  return d_first;
+}
+
+// Packs the comparison of each element with the threshold into 64-bit words,
+// element i at bit i % 64 of word i / 64; bits past the end are zero
+template <class InputIt, class WordIt, typename Rep, typename Unit>
+WordIt compare_mask(InputIt first, InputIt last, WordIt d_first,
+                    comparison op, const quantity<Rep, Unit>& threshold) {
+  using Q = detail::iterator_value_t<InputIt>;
+  using T = typename Q::value_type;
+  constexpr std::size_t word_bits = 64;
+  const auto interval = detail::comparison_interval<Q>(op, threshold);
+  const T lo = interval.lower();
+  const T hi = interval.upper();
+  const bool inverted = op == comparison::not_equal;
+  while (first != last) {
+    // Elements past the end of the range are masked off after the loop
+    T block[word_bits] = {};
+    std::size_t n = 0;
+    for (; n < word_bits && first != last; ++n, ++first) {
+      block[n] = Q(*first).value();
+    }
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < word_bits; ++i) {
+      const bool hit = ((lo <= block[i]) & (block[i] <= hi)) != inverted;
+      word |= std::uint64_t(hit) << i;
+    }
+    *d_first = n < word_bits ? word & ((std::uint64_t(1) << n) - 1) : word;
+    ++d_first;
+  }
+  return d_first;
+}
+
+// Number of elements that compare true with the threshold
+template <class InputIt, typename Rep, typename Unit>
+std::size_t count_if(InputIt first, InputIt last, comparison op,
+                     const quantity<Rep, Unit>& threshold) {
+  using Q = detail::iterator_value_t<InputIt>;
+  using T = typename Q::value_type;
+  const auto interval = detail::comparison_interval<Q>(op, threshold);
+  const T lo = interval.lower();
+  const T hi = interval.upper();
+  const bool inverted = op == comparison::not_equal;
+  std::size_t count = 0;
+  for (; first != last; ++first) {
+    const T x = Q(*first).value();
+    count += ((lo <= x) & (x <= hi)) != inverted;
+  }
+  return count;
+}
+
+// Copies the elements that compare true with the threshold, in order
+template <class InputIt, class OutputIt, typename Rep, typename Unit>
+OutputIt select(InputIt first, InputIt last, OutputIt d_first, comparison op,
+                const quantity<Rep, Unit>& threshold) {
+  using Q = detail::iterator_value_t<InputIt>;
+  using T = typename Q::value_type;
+  const auto interval = detail::comparison_interval<Q>(op, threshold);
+  const T lo = interval.lower();
+  const T hi = interval.upper();
+  const bool inverted = op == comparison::not_equal;
+  for (; first != last; ++first) {
+    const T x = Q(*first).value();
+    if (((lo <= x) & (x <= hi)) != inverted) {
+      *d_first = *first;
+      ++d_first;
+    }
+  }
+  return d_first;
+}
+
+// Writes whether each element lies within the closed range [lo, hi]
+template <class InputIt, class OutputIt, typename Rep1, typename Unit1,
+          typename Rep2, typename Unit2>
+OutputIt in_range(InputIt first, InputIt last, OutputIt d_first,
+                  const quantity<Rep1, Unit1>& lo,
+                  const quantity<Rep2, Unit2>& hi) {
+  using Q = detail::iterator_value_t<InputIt>;
+  using T = typename Q::value_type;
+  detail::value_interval<Q> interval;
+  interval.above(lo, false);
+  interval.below(hi, false);
+  const T a = interval.lower();
+  const T b = interval.upper();
+  for (; first != last; ++first, ++d_first) {
+    const T x = Q(*first).value();
+    *d_first = (a <= x) & (x <= b);
+  }
+  return d_first;
+}
+
+// Clamps each element to the closed range [lo, hi], which must contain a
+// value of the representation of the array
+template <class InputIt, class OutputIt, typename Rep1, typename Unit1,
+          typename Rep2, typename Unit2>
+OutputIt clamp(InputIt first, InputIt last, OutputIt d_first,
+               const quantity<Rep1, Unit1>& lo,
+               const quantity<Rep2, Unit2>& hi) {
+  using Q = detail::iterator_value_t<InputIt>;
+  using T = typename Q::value_type;
+  detail::value_interval<Q> interval;
+  interval.above(lo, false);
+  interval.below(hi, false);
+  const T a = interval.lower();
+  const T b = interval.upper();
+  for (; first != last; ++first, ++d_first) {
+    const T x = Q(*first).value();
+    *d_first = Q(x < a ? a : (b < x ? b : x));
+  }
+  return d_first;
+}
+
+}  // namespace scalr
+
+#endif
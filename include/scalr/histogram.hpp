@@ -0,0 +1,218 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_HISTOGRAM_HPP
+#define SCALR_HISTOGRAM_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "scalr/bits.hpp"
+#include "scalr/named_quantity/time.hpp"
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+
+/* Class template log-linear histogram of durations
+ *
+ * Durations are counted in ticks of Duration, which must have an integral
+ * representation. Each power-of-two range of ticks from 2^Precision upwards
+ * is split into 2^Precision equal buckets, so bucket widths stay within a
+ * relative error of 2^-Precision; smaller tick counts are exact. The bucket
+ * of a sample is found from the position of its highest set bit.
+ *
+ * Recording is not synchronized. Each thread records into a histogram of its
+ * own, and histograms are combined with merge(), which adds bucket counts.
+ */
+template <typename Duration, unsigned Precision = 5>
+class log_histogram {
+  static_assert(std::is_same<typename Duration::dimension,
+                             time_dimension>::value,
+                "log_histogram requires a duration type");
+  static_assert(std::is_integral<typename Duration::value_type>::value,
+                "log_histogram requires an integral tick count");
+  static_assert(Precision >= 1 && Precision <= 16,
+                "log_histogram precision must be between 1 and 16 bits");
+
+ public:
+  using duration_type = Duration;
+  static constexpr unsigned precision = Precision;
+  static constexpr std::size_t bucket_count =
+      std::size_t(64 - Precision + 1) << Precision;
+
+  log_histogram()
+      : counts_(bucket_count, 0),
+        total_(0),
+        min_(std::numeric_limits<std::uint64_t>::max()),
+        max_(0) {}
+
+  // Records a duration in any unit; negative durations count as zero
+  template <typename Rep, typename Unit>
+  void record(const quantity<Rep, Unit>& sample, std::uint64_t count = 1) {
+    const auto ticks = quantity_cast<Duration>(sample).value();
+    const std::uint64_t value =
+        ticks > 0 ? static_cast<std::uint64_t>(ticks) : 0;
+    counts_[bucket_index(value)] += count;
+    total_ += count;
+    min_ = value < min_ ? value : min_;
+    max_ = value > max_ ? value : max_;
+  }
+
+  // Adds the counts of a histogram recorded elsewhere
+  void merge(const log_histogram& other) {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    min_ = other.min_ < min_ ? other.min_ : min_;
+    max_ = other.max_ > max_ ? other.max_ : max_;
+  }
+
+  void reset() { *this = log_histogram(); }
+
+  std::uint64_t count() const { return total_; }
+
+  template <typename Target = Duration>
+  Target min() const {
+    return quantity_cast<Target>(ticks(total_ ? min_ : 0));
+  }
+
+  template <typename Target = Duration>
+  Target max() const {
+    return quantity_cast<Target>(ticks(max_));
+  }
+
+  // The smallest duration that at least the given percentage of samples do
+  // not exceed, up to the bucket resolution. The result is the largest tick
+  // count of its bucket, clamped to the recorded range.
+  template <typename Target = Duration>
+  Target percentile(double percentage) const {
+    if (total_ == 0) {
+      return quantity_cast<Target>(ticks(0));
+    }
+    const double clamped =
+        percentage < 0 ? 0 : (percentage > 100 ? 100 : percentage);
+    // The rank of the sample in 1..total, rounded up so that at least the
+    // percentage of samples is at or below it
+    std::uint64_t rank = static_cast<std::uint64_t>(
+        std::ceil(clamped * static_cast<double>(total_) / 100));
+    rank = rank == 0 ? 1 : (rank > total_ ? total_ : rank);
+
+    std::uint64_t seen = 0;
+    std::size_t i = 0;
+    for (; i < bucket_count; ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        break;
+      }
+    }
+
+    std::uint64_t value = bucket_lower(i) + bucket_width(i) - 1;
+    value = value > max_ ? max_ : value;
+    value = value < min_ ? min_ : value;
+    return quantity_cast<Target>(ticks(value));
+  }
+
+  // Run-length encoded nonzero buckets as LEB128 varints
+  std::vector<std::uint8_t> serialize() const {
+    std::vector<std::uint8_t> out;
+    detail::put_varint(out, Precision);
+    detail::put_varint(out, total_ ? min_ : 0);
+    detail::put_varint(out, max_);
+    std::size_t previous = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      if (counts_[i] != 0) {
+        detail::put_varint(out, i - previous);
+        detail::put_varint(out, counts_[i]);
+        previous = i;
+      }
+    }
+    return out;
+  }
+
+  // Replaces the contents with a serialized histogram. Returns false and
+  // leaves the histogram unchanged if the input is malformed or was written
+  // with a different precision.
+  template <class InputIt>
+  bool deserialize(InputIt first, InputIt last) {
+    log_histogram result;
+    std::uint64_t precision_bits, min_value, max_value;
+    if (!detail::get_varint(first, last, precision_bits) ||
+        precision_bits != Precision ||
+        !detail::get_varint(first, last, min_value) ||
+        !detail::get_varint(first, last, max_value)) {
+      return false;
+    }
+
+    std::uint64_t index = 0;
+    while (first != last) {
+      std::uint64_t gap, count;
+      if (!detail::get_varint(first, last, gap) ||
+          !detail::get_varint(first, last, count) ||
+          gap >= bucket_count - index) {
+        return false;
+      }
+      index += gap;
+      result.counts_[index] += count;
+      result.total_ += count;
+    }
+    result.min_ = result.total_ ? min_value : result.min_;
+    result.max_ = max_value;
+    *this = result;
+    return true;
+  }
+
+  // Bucket of a tick count: the exponent above Precision selects a group of
+  // 2^Precision buckets and the next Precision bits select one within it
+  static std::size_t bucket_index(std::uint64_t value) {
+    const unsigned bit = detail::highest_bit(value | 1);
+    const unsigned shift = bit > Precision ? bit - Precision : 0;
+    return (std::size_t(shift) << Precision) +
+           static_cast<std::size_t>(value >> shift);
+  }
+
+  static std::uint64_t bucket_lower(std::size_t index) {
+    const std::size_t group = index >> Precision;
+    if (group <= 1) {
+      return index;
+    }
+    const std::uint64_t mask = (std::uint64_t(1) << Precision) - 1;
+    const std::uint64_t mantissa = (mask + 1) | (index & mask);
+    return mantissa << (group - 1);
+  }
+
+  static std::uint64_t bucket_width(std::size_t index) {
+    const std::size_t group = index >> Precision;
+    return group <= 1 ? 1 : std::uint64_t(1) << (group - 1);
+  }
+
+ private:
+  static Duration ticks(std::uint64_t value) {
+    return Duration(static_cast<typename Duration::value_type>(value));
+  }
+
+  std::vector<std::uint64_t> counts_;
+  std::uint64_t total_;
+  std::uint64_t min_;
+  std::uint64_t max_;
+};
+
+template <typename Duration, unsigned Precision>
+constexpr unsigned log_histogram<Duration, Precision>::precision;
+
+template <typename Duration, unsigned Precision>
+constexpr std::size_t log_histogram<Duration, Precision>::bucket_count;
+
+}  // namespace scalr
+
+#endif
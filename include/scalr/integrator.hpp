@@ -0,0 +1,170 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_INTEGRATOR_HPP
+#define SCALR_INTEGRATOR_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "scalr/quantity.hpp"
+#include "scalr/quantity_vector.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Position X, velocity V and acceleration A form a kinematic chain over the
+// step type T if V * T has the dimension of X and A * T that of V
+template <typename X, typename V, typename A, typename T>
+struct kinematic_chain {
+  static_assert(std::is_floating_point<typename T::value_type>::value,
+                "integration steps require a floating-point representation");
+  static_assert(std::is_same<typename quantity_product_t<V, T>::dimension,
+                             typename X::dimension>::value,
+                "velocity times step must have the dimension of position");
+  static_assert(std::is_same<typename quantity_product_t<A, T>::dimension,
+                             typename V::dimension>::value,
+                "acceleration times step must have the dimension of velocity");
+
+  // Integrates a derivative over a step into the unit of its integral
+  template <typename Q, typename D>
+  static constexpr Q integrate(const D& derivative, const T& step) {
+    return quantity_cast<Q>(derivative * step);
+  }
+};
+
+}  // namespace detail
+
+/* Fixed-step integrators of Newtonian mechanics
+ *
+ * The state of N particles is given as struct-of-arrays ranges of positions,
+ * velocities and accelerations. Every kernel is a single pass over a range of
+ * particles, so large systems may be split into sub-ranges and integrated
+ * concurrently as long as accelerations do not couple the sub-ranges.
+ * Acceleration callbacks have the form accel(x_first, x_last, a_first) or,
+ * for rk4_integrator, accel(x_first, x_last, v_first, a_first).
+ */
+
+// Semi-implicit Euler: v += a * dt, then x += v * dt
+template <class XIt, class VIt, class AIt, class Rep, class Unit>
+void euler_step(XIt x_first, XIt x_last, VIt v_first, AIt a_first,
+                const quantity<Rep, Unit>& dt) {
+  using X = detail::iterator_value_t<XIt>;
+  using V = detail::iterator_value_t<VIt>;
+  using chain = detail::kinematic_chain<X, V, detail::iterator_value_t<AIt>,
+                                        quantity<Rep, Unit>>;
+
+  for (; x_first != x_last; ++x_first, ++v_first, ++a_first) {
+    *v_first += chain::template integrate<V>(*a_first, dt);
+    *x_first += chain::template integrate<X>(*v_first, dt);
+  }
+}
+
+// Velocity Verlet (kick-drift-kick). Accelerations must hold the values for
+// the current positions and are updated to the new positions.
+template <class XIt, class VIt, class AIt, class Rep, class Unit,
+          class Acceleration>
+void verlet_step(XIt x_first, XIt x_last, VIt v_first, AIt a_first,
+                 const quantity<Rep, Unit>& dt, Acceleration accel) {
+  using X = detail::iterator_value_t<XIt>;
+  using V = detail::iterator_value_t<VIt>;
+  using chain = detail::kinematic_chain<X, V, detail::iterator_value_t<AIt>,
+                                        quantity<Rep, Unit>>;
+  const quantity<Rep, Unit> half = dt / 2;
+
+  XIt x = x_first;
+  VIt v = v_first;
+  AIt a = a_first;
+  for (; x != x_last; ++x, ++v, ++a) {
+    *v += chain::template integrate<V>(*a, half);
+    *x += chain::template integrate<X>(*v, dt);
+  }
+
+  accel(x_first, x_last, a_first);
+
+  for (x = x_first; x != x_last; ++x, ++v_first, ++a_first) {
+    *v_first += chain::template integrate<V>(*a_first, half);
+  }
+}
+
+// Classical fourth-order Runge-Kutta for x' = v, v' = a(x, v). The stage
+// buffers are kept between steps to avoid allocations.
+template <class X, class V, class A>
+class rk4_integrator {
+ public:
+  template <class XIt, class VIt, class Rep, class Unit, class Acceleration>
+  void step(XIt x_first, XIt x_last, VIt v_first,
+            const quantity<Rep, Unit>& dt, Acceleration accel) {
+    using T = quantity<Rep, Unit>;
+    using chain = detail::kinematic_chain<X, V, A, T>;
+    static_assert(std::is_same<detail::iterator_value_t<XIt>, X>::value &&
+                      std::is_same<detail::iterator_value_t<VIt>, V>::value,
+                  "state ranges must match the integrator quantities");
+
+    const std::size_t n =
+        static_cast<std::size_t>(std::distance(x_first, x_last));
+    resize(n);
+    const T half = dt / 2;
+    const T sixth = dt / 6;
+
+    // Stage 1 from the current state
+    accel(x_first, x_last, v_first, a_.begin());
+    XIt x = x_first;
+    VIt v = v_first;
+    for (std::size_t i = 0; i < n; ++i, ++x, ++v) {
+      sum_x_[i] = *v;
+      sum_v_[i] = a_[i];
+      x_[i] = *x + chain::template integrate<X>(*v, half);
+      v_[i] = *v + chain::template integrate<V>(a_[i], half);
+    }
+
+    // Stages 2 and 3 from the midpoint estimates
+    for (int stage = 0; stage < 2; ++stage) {
+      const T h = stage == 0 ? half : dt;
+      accel(x_.begin(), x_.end(), v_.begin(), a_.begin());
+      x = x_first;
+      v = v_first;
+      for (std::size_t i = 0; i < n; ++i, ++x, ++v) {
+        sum_x_[i] += v_[i] + v_[i];
+        sum_v_[i] += a_[i] + a_[i];
+        x_[i] = *x + chain::template integrate<X>(v_[i], h);
+        v_[i] = *v + chain::template integrate<V>(a_[i], h);
+      }
+    }
+
+    // Stage 4 from the endpoint estimate and the weighted update
+    accel(x_.begin(), x_.end(), v_.begin(), a_.begin());
+    for (std::size_t i = 0; i < n; ++i, ++x_first, ++v_first) {
+      sum_x_[i] += v_[i];
+      sum_v_[i] += a_[i];
+      *x_first += chain::template integrate<X>(sum_x_[i], sixth);
+      *v_first += chain::template integrate<V>(sum_v_[i], sixth);
+    }
+  }
+
+ private:
+  void resize(std::size_t n) {
+    x_.resize(n);
+    v_.resize(n);
+    a_.resize(n);
+    sum_x_.resize(n);
+    sum_v_.resize(n);
+  }
+
+  std::vector<X> x_;
+  std::vector<V> v_;
+  std::vector<A> a_;
+  std::vector<V> sum_x_;
+  std::vector<A> sum_v_;
+};
+
+}  // namespace scalr
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_JOIN_HPP
+#define SCALR_JOIN_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include "scalr/math.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/quantity_vector.hpp"
+
+namespace scalr {
+
+// The right-hand sample joined to a left-hand timestamp: the latest one at
+// or before it, the earliest one at or after it, the closer of both (the
+// earlier on ties), or a linear interpolation between both
+enum class join_mode { backward, forward, nearest, linear };
+
+/* As-of join of a sampled series onto the timestamps of another
+ *
+ * For each timestamp in [left_first, left_last), writes the right-hand value
+ * selected by the mode to d_first and whether one was found within the
+ * tolerance to matched_first. Both timestamp columns must be sorted, and the
+ * right-hand columns must be random access. The right-hand cursor only moves
+ * forward, so the join takes time linear in the length of both columns.
+ *
+ * Timestamps are compared exactly in the common unit of both columns. Joined
+ * values are in the unit of the right-hand values with a floating-point
+ * representation; a timestamp without a match gets a zero value. Linear
+ * interpolation requires samples on both sides within the tolerance, unless
+ * one is exactly at the timestamp.
+ */
+template <class LeftIt, class RightIt, class ValueIt, class OutputIt,
+          class MatchIt, class Rep, class Unit>
+std::pair<OutputIt, MatchIt> asof_join(LeftIt left_first, LeftIt left_last,
+                                       RightIt right_first,
+                                       RightIt right_last,
+                                       ValueIt value_first, OutputIt d_first,
+                                       MatchIt matched_first,
+                                       const quantity<Rep, Unit>& tolerance,
+                                       join_mode mode = join_mode::backward) {
+  using time_type = quantity_sum_t<detail::iterator_value_t<LeftIt>,
+                                   detail::iterator_value_t<RightIt>>;
+  using V = detail::iterator_value_t<ValueIt>;
+  using F = detail::floating_value_t<typename V::value_type>;
+  using result_type = quantity<F, typename V::unit>;
+  using tick = typename time_type::value_type;
+
+  const tick limit = quantity_cast<time_type>(tolerance).value();
+  const std::ptrdiff_t n = right_last - right_first;
+  std::ptrdiff_t j = 0;
+
+  for (; left_first != left_last; ++left_first, ++d_first, ++matched_first) {
+    const tick t = time_type(*left_first).value();
+    while (j < n && !(t < time_type(right_first[j]).value())) {
+      ++j;
+    }
+
+    // Samples before or at t end at j - 1, samples after t start at j
+    const bool has_prev = j > 0;
+    const bool has_next = j < n;
+    const std::ptrdiff_t prev = has_prev ? j - 1 : 0;
+    const std::ptrdiff_t next = has_next ? j : 0;
+    const tick before =
+        has_prev ? t - time_type(right_first[prev]).value() : tick(0);
+    const tick after =
+        has_next ? time_type(right_first[next]).value() - t : tick(0);
+    const bool prev_ok = has_prev && !(limit < before);
+    const bool next_ok = has_next && !(limit < after);
+    const bool exact = has_prev && before == 0;
+
+    bool use_prev = false;
+    bool matched = false;
+    F fraction = 0;
+    switch (mode) {
+      case join_mode::backward:
+        use_prev = true;
+        matched = prev_ok;
+        break;
+      case join_mode::forward:
+        use_prev = exact;
+        matched = exact || next_ok;
+        break;
+      case join_mode::nearest:
+        use_prev = prev_ok && (!next_ok || !(after < before));
+        matched = prev_ok || next_ok;
+        break;
+      case join_mode::linear:
+        use_prev = true;
+        matched = exact || (prev_ok && next_ok);
+        fraction = (exact || !matched) ? F(0)
+                                       : static_cast<F>(before) /
+                                             static_cast<F>(before + after);
+        break;
+    }
+
+    const std::ptrdiff_t k = use_prev ? prev : next;
+    const F y0 = matched ? result_type(value_first[k]).value() : F(0);
+    const F y1 = fraction != 0 ? result_type(value_first[next]).value() : y0;
+    *d_first = result_type(y0 + fraction * (y1 - y0));
+    *matched_first = matched;
+  }
+  return std::pair<OutputIt, MatchIt>(d_first, matched_first);
+}
+
+}  // namespace scalr
+
+#endif
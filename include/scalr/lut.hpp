@@ -0,0 +1,342 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_LUT_HPP
+#define SCALR_LUT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "scalr/math.hpp"
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+
+enum class interpolation { nearest, linear, cubic };
+
+/* Class template lookup table from X quantities to Y quantities
+ *
+ * Samples are stored as values in the units of XQ and YQ. Tables on a uniform
+ * grid locate the interval of an argument with one multiply by the reciprocal
+ * step; other tables use binary search. Arguments outside the grid are
+ * clamped to its ends and NaN arguments give NaN. Cubic interpolation is
+ * piecewise cubic Hermite with central-difference slopes. The constructors
+ * throw std::invalid_argument unless there are at least two samples and as
+ * many grid points as samples.
+ */
+template <typename XQ, typename YQ>
+class quantity_lut {
+ public:
+  using value_type = detail::floating_value_t<
+      typename std::common_type<typename XQ::value_type,
+                                typename YQ::value_type>::type>;
+  using argument_type = quantity<value_type, typename XQ::unit>;
+  using result_type = quantity<value_type, typename YQ::unit>;
+  using derivative_type =
+      quantity<value_type, unit_product_t<typename YQ::unit,
+                                          unit_inverse_t<typename XQ::unit>>>;
+
+  // Uniform grid of samples at first + i * step
+  quantity_lut(const XQ& first, const XQ& step, const std::vector<YQ>& ys)
+      : uniform_(true),
+        first_(argument_type(first).value()),
+        step_(argument_type(step).value()),
+        inverse_step_(1 / step_),
+        y_(values(ys)) {
+    check_size(y_.size(), y_.size());
+    for (std::size_t i = 0; i < y_.size(); ++i) {
+      x_.push_back(first_ + static_cast<value_type>(i) * step_);
+    }
+    init_slopes();
+  }
+
+  // Samples at increasing grid points
+  quantity_lut(const std::vector<XQ>& xs, const std::vector<YQ>& ys)
+      : uniform_(false),
+        first_(0),
+        step_(0),
+        inverse_step_(0),
+        x_(values(xs)),
+        y_(values(ys)) {
+    check_size(x_.size(), y_.size());
+    first_ = x_.front();
+    init_slopes();
+  }
+
+  std::size_t size() const { return y_.size(); }
+  bool uniform() const { return uniform_; }
+
+  result_type operator()(const argument_type& x,
+                         interpolation mode = interpolation::linear) const {
+    const value_type u = x.value();
+    if (u != u) {
+      return result_type(u);
+    }
+    const std::size_t i = interval(u);
+    const value_type h = x_[i + 1] - x_[i];
+    const value_type t = clamp((u - x_[i]) / h);
+
+    switch (mode) {
+      case interpolation::nearest:
+        return result_type(t < value_type(0.5) ? y_[i] : y_[i + 1]);
+      case interpolation::cubic:
+        return result_type(hermite(i, t, h));
+      default:
+        return result_type(y_[i] + t * (y_[i + 1] - y_[i]));
+    }
+  }
+
+  // Slope of the interpolant at x in units of Y per X
+  derivative_type derivative(
+      const argument_type& x,
+      interpolation mode = interpolation::linear) const {
+    const value_type u = x.value();
+    if (u != u) {
+      return derivative_type(u);
+    }
+    const std::size_t i = interval(u);
+    const value_type h = x_[i + 1] - x_[i];
+
+    if (mode != interpolation::cubic) {
+      return derivative_type((y_[i + 1] - y_[i]) / h);
+    }
+
+    const value_type t = clamp((u - x_[i]) / h);
+    const value_type t2 = t * t;
+    return derivative_type(
+        ((6 * t2 - 6 * t) * y_[i] + (3 * t2 - 4 * t + 1) * h * m_[i] +
+         (6 * t - 6 * t2) * y_[i + 1] + (3 * t2 - 2 * t) * h * m_[i + 1]) /
+        h);
+  }
+
+  // Batch evaluation. Linear interpolation on a uniform grid clamps the
+  // scaled argument instead of branching, so the loop body is straight-line
+  // code apart from the two sample loads. NaN arguments are clamped to the
+  // first interval and their results are selected as NaN.
+  template <class InputIt, class OutputIt>
+  OutputIt operator()(InputIt first, InputIt last, OutputIt d_first,
+                      interpolation mode = interpolation::linear) const {
+    if (uniform_ && mode == interpolation::linear) {
+      const value_type last_interval = static_cast<value_type>(size() - 2);
+      const value_type origin = first_;
+      const value_type inverse_step = inverse_step_;
+      const value_type* y = y_.data();
+      for (; first != last; ++first, ++d_first) {
+        const value_type x = argument_type(*first).value();
+        const value_type u =
+            clamp_index((x - origin) * inverse_step, last_interval + 1);
+        const std::ptrdiff_t i =
+            static_cast<std::ptrdiff_t>(std::min(u, last_interval));
+        const value_type t = u - static_cast<value_type>(i);
+        const value_type r = y[i] + t * (y[i + 1] - y[i]);
+        *d_first = result_type(x == x ? r : x);
+      }
+      return d_first;
+    }
+
+    for (; first != last; ++first, ++d_first) {
+      *d_first = (*this)(argument_type(*first), mode);
+    }
+    return d_first;
+  }
+
+ private:
+  template <typename Q>
+  static std::vector<value_type> values(const std::vector<Q>& qs) {
+    using target = quantity<value_type, typename Q::unit>;
+    std::vector<value_type> result;
+    result.reserve(qs.size());
+    for (const Q& q : qs) {
+      result.push_back(target(q).value());
+    }
+    return result;
+  }
+
+  static void check_size(std::size_t points, std::size_t samples) {
+    if (samples < 2) {
+      throw std::invalid_argument("a lookup table requires two samples");
+    }
+    if (points != samples) {
+      throw std::invalid_argument("grid points and samples must match");
+    }
+  }
+
+  static value_type clamp(value_type t) {
+    return std::min(std::max(t, value_type(0)), value_type(1));
+  }
+
+  // Clamps u to [0, hi] and NaN to 0, so that the result converts to an index
+  static value_type clamp_index(value_type u, value_type hi) {
+    return u > 0 ? (u < hi ? u : hi) : value_type(0);
+  }
+
+  // Index of the interval [x_i, x_i+1] containing or closest to u
+  std::size_t interval(value_type u) const {
+    const std::size_t last = size() - 2;
+    if (uniform_) {
+      const value_type k = clamp_index(std::floor((u - first_) * inverse_step_),
+                                       static_cast<value_type>(last));
+      return static_cast<std::size_t>(k);
+    }
+    const std::size_t k = static_cast<std::size_t>(
+        std::upper_bound(x_.begin(), x_.end(), u) - x_.begin());
+    return k == 0 ? 0 : std::min(k - 1, last);
+  }
+
+  void init_slopes() {
+    const std::size_t n = size();
+    m_.resize(n);
+    m_[0] = (y_[1] - y_[0]) / (x_[1] - x_[0]);
+    m_[n - 1] = (y_[n - 1] - y_[n - 2]) / (x_[n - 1] - x_[n - 2]);
+    for (std::size_t i = 1; i + 1 < n; ++i) {
+      m_[i] = (y_[i + 1] - y_[i - 1]) / (x_[i + 1] - x_[i - 1]);
+    }
+  }
+
+  value_type hermite(std::size_t i, value_type t, value_type h) const {
+    const value_type t2 = t * t;
+    const value_type t3 = t2 * t;
+    return (2 * t3 - 3 * t2 + 1) * y_[i] + (t3 - 2 * t2 + t) * h * m_[i] +
+           (3 * t2 - 2 * t3) * y_[i + 1] + (t3 - t2) * h * m_[i + 1];
+  }
+
+  bool uniform_;
+  value_type first_;
+  value_type step_;
+  value_type inverse_step_;
+  std::vector<value_type> x_;
+  std::vector<value_type> y_;
+  std::vector<value_type> m_;
+};
+
+/* Class template two-dimensional lookup table on a uniform grid
+ *
+ * Maps (X, Y) quantities to Z quantities with nearest, bilinear or bicubic
+ * interpolation. Samples are given row by row, with X varying fastest. The
+ * constructor throws std::invalid_argument unless the samples fill whole
+ * rows and there are at least two samples along each axis. NaN arguments
+ * give NaN. Bicubic interpolation
+ * applies the cubic Hermite interpolation of quantity_lut along X and then
+ * along Y, with central-difference slopes.
+ */
+template <typename XQ, typename YQ, typename ZQ>
+class quantity_lut2 {
+ public:
+  using value_type = detail::floating_value_t<typename std::common_type<
+      typename XQ::value_type, typename YQ::value_type,
+      typename ZQ::value_type>::type>;
+  using x_type = quantity<value_type, typename XQ::unit>;
+  using y_type = quantity<value_type, typename YQ::unit>;
+  using result_type = quantity<value_type, typename ZQ::unit>;
+
+  quantity_lut2(const XQ& x_first, const XQ& x_step, std::size_t x_size,
+                const YQ& y_first, const YQ& y_step,
+                const std::vector<ZQ>& zs)
+      : x_first_(x_type(x_first).value()),
+        x_inverse_step_(1 / x_type(x_step).value()),
+        y_first_(y_type(y_first).value()),
+        y_inverse_step_(1 / y_type(y_step).value()),
+        x_size_(x_size),
+        y_size_(x_size != 0 ? zs.size() / x_size : 0) {
+    if (x_size_ < 2 || y_size_ < 2) {
+      throw std::invalid_argument(
+          "a lookup table requires two samples along each axis");
+    }
+    if (zs.size() != x_size_ * y_size_) {
+      throw std::invalid_argument("samples must fill whole rows of the grid");
+    }
+    z_.reserve(zs.size());
+    for (const ZQ& z : zs) {
+      z_.push_back(result_type(z).value());
+    }
+  }
+
+  result_type operator()(const x_type& x, const y_type& y,
+                         interpolation mode = interpolation::linear) const {
+    if (x.value() != x.value() || y.value() != y.value()) {
+      return result_type(std::numeric_limits<value_type>::quiet_NaN());
+    }
+    std::size_t i, j;
+    value_type s, t;
+    locate((x.value() - x_first_) * x_inverse_step_, x_size_, i, s);
+    locate((y.value() - y_first_) * y_inverse_step_, y_size_, j, t);
+
+    const value_type* row0 = z_.data() + j * x_size_;
+    const value_type* row1 = row0 + x_size_;
+
+    if (mode == interpolation::nearest) {
+      return result_type((t < value_type(0.5) ? row0 : row1)
+                             [s < value_type(0.5) ? i : i + 1]);
+    }
+
+    if (mode == interpolation::cubic) {
+      const value_type z1 = cubic_row(row0, i, s);
+      const value_type z2 = cubic_row(row1, i, s);
+      const value_type z0 =
+          j > 0 ? cubic_row(row0 - x_size_, i, s) : 2 * z1 - z2;
+      const value_type z3 =
+          j + 2 < y_size_ ? cubic_row(row1 + x_size_, i, s) : 2 * z2 - z1;
+      return result_type(hermite(z0, z1, z2, z3, t));
+    }
+
+    const value_type z0 = row0[i] + s * (row0[i + 1] - row0[i]);
+    const value_type z1 = row1[i] + s * (row1[i + 1] - row1[i]);
+    return result_type(z0 + t * (z1 - z0));
+  }
+
+ private:
+  static void locate(value_type u, std::size_t size, std::size_t& index,
+                     value_type& fraction) {
+    const value_type last = static_cast<value_type>(size - 2);
+    const value_type clamped =
+        u > 0 ? (u < last + 1 ? u : last + 1) : value_type(0);
+    const value_type k = std::min(std::floor(clamped), last);
+    index = static_cast<std::size_t>(k);
+    fraction = clamped - k;
+  }
+
+  // Cubic Hermite interpolation between p1 and p2 on a unit grid. The slopes
+  // are central differences, and one-sided at the ends of the grid where a
+  // missing neighbor is extrapolated linearly.
+  static value_type hermite(value_type p0, value_type p1, value_type p2,
+                            value_type p3, value_type t) {
+    const value_type t2 = t * t;
+    const value_type t3 = t2 * t;
+    const value_type m1 = (p2 - p0) / 2;
+    const value_type m2 = (p3 - p1) / 2;
+    return (2 * t3 - 3 * t2 + 1) * p1 + (t3 - 2 * t2 + t) * m1 +
+           (3 * t2 - 2 * t3) * p2 + (t3 - t2) * m2;
+  }
+
+  value_type cubic_row(const value_type* row, std::size_t i,
+                       value_type s) const {
+    const value_type p1 = row[i];
+    const value_type p2 = row[i + 1];
+    const value_type p0 = i > 0 ? row[i - 1] : 2 * p1 - p2;
+    const value_type p3 = i + 2 < x_size_ ? row[i + 2] : 2 * p2 - p1;
+    return hermite(p0, p1, p2, p3, s);
+  }
+
+  value_type x_first_;
+  value_type x_inverse_step_;
+  value_type y_first_;
+  value_type y_inverse_step_;
+  std::size_t x_size_;
+  std::size_t y_size_;
+  std::vector<value_type> z_;
+};
+
+}  // namespace scalr
+
+#endif
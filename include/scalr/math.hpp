@@ -0,0 +1,164 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_MATH_HPP
+#define SCALR_MATH_HPP
+
+#include <cmath>
+#include <type_traits>
+
+#include "scalr/dimension.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+namespace detail {
+
+// x^N by repeated squaring, unrolled into multiplies at compile time
+template <intmax_t N, bool Negative = (N < 0), bool Odd = (N % 2 != 0)>
+struct integer_power {
+  template <typename T>
+  static constexpr T apply(const T& x) {
+    return integer_power<N / 2>::apply(static_cast<T>(x * x));
+  }
+};
+
+template <intmax_t N>
+struct integer_power<N, false, true> {
+  template <typename T>
+  static constexpr T apply(const T& x) {
+    return static_cast<T>(x * integer_power<N - 1>::apply(x));
+  }
+};
+
+template <>
+struct integer_power<1, false, true> {
+  template <typename T>
+  static constexpr T apply(const T& x) {
+    return x;
+  }
+};
+
+template <>
+struct integer_power<0, false, false> {
+  template <typename T>
+  static constexpr T apply(const T&) {
+    return T(1);
+  }
+};
+
+template <intmax_t N, bool Odd>
+struct integer_power<N, true, Odd> {
+  template <typename T>
+  static constexpr T apply(const T& x) {
+    return T(1) / integer_power<-N>::apply(x);
+  }
+};
+
+template <typename Rep>
+using floating_value_t =
+    typename std::conditional<std::is_floating_point<Rep>::value, Rep,
+                              double>::type;
+
+// The k-th root of a quantity is taken in the unit whose root is exact, which
+// is the coherent unit of the dimension if the unit itself has none
+template <intmax_t k, typename Rep, typename Unit>
+struct quantity_root {
+  using root = unit::root<Unit, k>;
+  using value_type = floating_value_t<Rep>;
+  using source = quantity<
+      value_type,
+      typename std::conditional<root::exact, Unit,
+                                make_unit_t<typename Unit::dimension>>::type>;
+  using type = quantity<value_type, typename root::type>;
+};
+
+template <typename T>
+constexpr typename std::enable_if<!std::is_floating_point<T>::value, T>::type
+fused_multiply_add(const T& x, const T& y, const T& z) {
+  return x * y + z;
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type
+fused_multiply_add(const T& x, const T& y, const T& z) {
+  return std::fma(x, y, z);
+}
+
+}  // namespace detail
+
+//******************************
+// Power Functions
+//******************************
+
+// Integer power of a quantity as a chain of multiplies
+template <intmax_t N, typename Rep, typename Unit>
+constexpr quantity<Rep, unit_exponent_t<Unit, N>> pow(
+    const quantity<Rep, Unit>& q) {
+  static_assert(N >= 0 || std::is_floating_point<Rep>::value,
+                "negative powers require a floating-point representation");
+  return quantity<Rep, unit_exponent_t<Unit, N>>(
+      detail::integer_power<N>::apply(q.value()));
+}
+
+// Square and cubic roots of quantities whose dimension exponents are all
+// divisible by two and three respectively
+template <typename Rep, typename Unit>
+typename detail::quantity_root<2, Rep, Unit>::type sqrt(
+    const quantity<Rep, Unit>& q) {
+  using root = detail::quantity_root<2, Rep, Unit>;
+  return typename root::type(
+      std::sqrt(typename root::source(q).value()));
+}
+
+template <typename Rep, typename Unit>
+typename detail::quantity_root<3, Rep, Unit>::type cbrt(
+    const quantity<Rep, Unit>& q) {
+  using root = detail::quantity_root<3, Rep, Unit>;
+  return typename root::type(
+      std::cbrt(typename root::source(q).value()));
+}
+
+// The square root of a^2 + b^2 without intermediate overflow or underflow
+template <typename T1, typename U1, typename T2, typename U2>
+quantity<detail::floating_value_t<typename std::common_type<T1, T2>::type>,
+         unit_sum_t<U1, U2>>
+hypot(const quantity<T1, U1>& a, const quantity<T2, U2>& b) {
+  using F = detail::floating_value_t<typename std::common_type<T1, T2>::type>;
+  using cross = detail::quantity_cross<quantity<T1, U1>, quantity<T2, U2>>;
+  return quantity<F, unit_sum_t<U1, U2>>(std::hypot(
+      static_cast<F>(cross::left(a)), static_cast<F>(cross::right(b))));
+}
+
+// a * b + c rounded once, where c has the dimension of a * b. The product
+// unit and the unit of c are reconciled by scaling a and c, which is a no-op
+// whenever c is in the product unit.
+template <typename T1, typename U1, typename T2, typename U2, typename T3,
+          typename U3>
+quantity_sum_t<quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>,
+               quantity<T3, U3>>
+fma(const quantity<T1, U1>& a, const quantity<T2, U2>& b,
+    const quantity<T3, U3>& c) {
+  using product_type = quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>;
+  using result_type = quantity_sum_t<product_type, quantity<T3, U3>>;
+  static_assert(std::is_same<typename product_type::dimension,
+                             typename U3::dimension>::value,
+                "fma addend must have the dimension of the product");
+
+  using cross = detail::quantity_cross<product_type, quantity<T3, U3>>;
+  using V = typename cross::value_type;
+  return result_type(static_cast<typename result_type::value_type>(
+      detail::fused_multiply_add(cross::left(product_type(a.value())),
+                                 static_cast<V>(b.value()),
+                                 cross::right(c))));
+}
+
+}  // namespace scalr
+
+#endif
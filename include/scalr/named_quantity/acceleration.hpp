@@ -58,6 +58,11 @@ template <>
 struct make<acceleration_dimension, std::ratio<1>> {
   using type = meters_per_second_squared;
 };
+
+template <>
+struct named<acceleration_dimension> {
+  using type = unit_list<meters_per_second_squared>;
+};
 }  // namespace unit
 
 using meters_per_second_squared = acceleration<double, std::ratio<1>>;
@@ -49,9 +49,10 @@ struct reduced_radians {  // revolution, rotation, radians/2*PI
   using ratio = std::ratio<1>;
 };
 
-struct radians {
+struct radians {  // 1/(2*PI) revolution, exact
   using dimension = angle_dimension;
-  using ratio = std::ratio<99532, 625378>;  // 1/(2*PI) Approx.
+  using ratio = std::ratio<1, 2>;
+  static constexpr intmax_t pi = -1;
 };
 
 struct gradians {
@@ -75,7 +76,7 @@ struct make<angle_dimension, std::ratio<1>> {
 };
 
 template <>
-struct make<angle_dimension, std::ratio<99532, 625378>> {
+struct make<angle_dimension, std::ratio<1, 2>, -1> {
   using type = radians;
 };
 
@@ -89,6 +90,11 @@ struct make<angle_dimension, std::ratio<1, 360>> {
   using type = degrees;
 };
 
+template <>
+struct named<angle_dimension> {
+  using type = unit_list<reduced_radians, radians, gradians, degrees>;
+};
+
 }  // namespace unit
 
 // namespace quantity_type {
@@ -105,7 +111,7 @@ struct make<angle_dimension, std::ratio<1, 360>> {
 // }  // namespace quantity_type
 
 using reduced_radians = angle<double>;
-using radians = angle<double, std::ratio<99532, 625378>>;
+using radians = quantity<double, unit::radians>;
 using gradians = angle<double, std::ratio<1, 400>>;
 using degrees = angle<double, std::ratio<1, 360>>;
 
@@ -87,6 +87,11 @@ struct make<area_dimension, std::ratio<1000000>> {
   using type = square_kilometers;
 };
 
+template <>
+struct named<area_dimension> {
+  using type = unit_list<square_meters, acres, hectares, square_kilometers>;
+};
+
 }  // namespace unit
 
 using square_meters = area<double, std::ratio<1>>;
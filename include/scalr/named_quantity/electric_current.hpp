@@ -80,6 +80,11 @@ struct make<electric_current_dimension, std::ratio<1>> {
   using type = ampers;
 };
 
+template <>
+struct named<electric_current_dimension> {
+  using type = unit_list<microampers, milliampers, ampers>;
+};
+
 }  // namespace unit
 
 using microampers = electric_current<double, std::ratio<1, 1000000>>;
@@ -58,6 +58,11 @@ struct volts {
   using dimension = electric_potential_dimension;
   using ratio = std::ratio<1>;
 };
+
+template <>
+struct named<electric_potential_dimension> {
+  using type = unit_list<microvolts, millivolts, volts>;
+};
 }  // namespace unit
 
 using microvolts = electric_potential<double, std::micro>;
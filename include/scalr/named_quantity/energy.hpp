@@ -0,0 +1,180 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_NAMED_QUANTITY_ENERGY_HPP
+#define SCALR_NAMED_QUANTITY_ENERGY_HPP
+
+#include <ratio>
+
+#include "scalr/dimension.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+
+struct energy_dimension {
+  // 7 Base SI dimensions + angle dimension
+  // SI base units	s−2⋅m2⋅kg
+  using signature = system_signature<-2, 2, 1, 0, 0, 0, 0, 0>;
+};
+
+template <typename Ratio>
+struct energy_unit {
+  using dimension = energy_dimension;
+  using ratio = Ratio;
+};
+
+template <typename Rep, typename Ratio = std::ratio<1>>
+using energy = quantity<Rep, make_unit_t<energy_dimension, Ratio>>;
+
+// Detail and specializations
+namespace dimension {
+
+template <>
+struct make<-2, 2, 1, 0, 0, 0, 0, 0> {
+  using type = energy_dimension;
+};
+
+}  // namespace dimension
+
+namespace unit {
+
+struct joules {
+  using dimension = energy_dimension;
+  using ratio = std::ratio<1>;
+};
+
+struct kilojoules {
+  using dimension = energy_dimension;
+  using ratio = std::kilo;
+};
+
+struct megajoules {
+  using dimension = energy_dimension;
+  using ratio = std::mega;
+};
+
+struct watt_hours {
+  using dimension = energy_dimension;
+  using ratio = std::ratio<3600>;
+};
+
+struct kilowatt_hours {
+  using dimension = energy_dimension;
+  using ratio = std::ratio<3600000>;
+};
+
+template <typename Ratio>
+struct make<energy_dimension, Ratio> {
+  using type = scalr::energy_unit<Ratio>;
+};
+
+template <>
+struct make<energy_dimension, std::ratio<1>> {
+  using type = joules;
+};
+
+template <>
+struct make<energy_dimension, std::kilo> {
+  using type = kilojoules;
+};
+
+template <>
+struct make<energy_dimension, std::mega> {
+  using type = megajoules;
+};
+
+template <>
+struct make<energy_dimension, std::ratio<3600>> {
+  using type = watt_hours;
+};
+
+template <>
+struct make<energy_dimension, std::ratio<3600000>> {
+  using type = kilowatt_hours;
+};
+
+template <>
+struct named<energy_dimension> {
+  using type =
+      unit_list<joules, kilojoules, megajoules, watt_hours, kilowatt_hours>;
+};
+
+}  // namespace unit
+
+using joules = energy<double, std::ratio<1>>;
+using kilojoules = energy<double, std::kilo>;
+using megajoules = energy<double, std::mega>;
+using watt_hours = energy<double, std::ratio<3600>>;
+using kilowatt_hours = energy<double, std::ratio<3600000>>;
+
+namespace literals {
+
+constexpr joules operator""_J(long double value) { return joules{value}; }
+
+constexpr kilojoules operator""_kJ(long double value) {
+  return kilojoules{value};
+}
+
+constexpr megajoules operator""_MJ(long double value) {
+  return megajoules{value};
+}
+
+constexpr watt_hours operator""_Wh(long double value) {
+  return watt_hours{value};
+}
+
+constexpr kilowatt_hours operator""_kWh(long double value) {
+  return kilowatt_hours{value};
+}
+
+constexpr joules operator""_J(unsigned long long value) {
+  return joules{value};
+}
+
+constexpr kilojoules operator""_kJ(unsigned long long value) {
+  return kilojoules{value};
+}
+
+constexpr megajoules operator""_MJ(unsigned long long value) {
+  return megajoules{value};
+}
+
+constexpr watt_hours operator""_Wh(unsigned long long value) {
+  return watt_hours{value};
+}
+
+constexpr kilowatt_hours operator""_kWh(unsigned long long value) {
+  return kilowatt_hours{value};
+}
+
+}  // namespace literals
+
+}  // namespace scalr
+
+// IO Helpers
+#if defined(ENABLE_SCALR_IO)
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os,
+                         const scalr::quantity<T, scalr::unit::joules>& q) {
+  os << q.value() << "J";
+  return os;
+}
+
+template <typename T>
+std::ostream& operator<<(
+    std::ostream& os,
+    const scalr::quantity<T, scalr::unit::kilowatt_hours>& q) {
+  os << q.value() << "kWh";
+  return os;
+}
+
+#endif
+#endif
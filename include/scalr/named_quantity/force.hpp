@@ -59,6 +59,11 @@ struct make<force_dimension, std::ratio<1>> {
   using type = newtons;
 };
 
+template <>
+struct named<force_dimension> {
+  using type = unit_list<newtons>;
+};
+
 }  // namespace unit
 
 using newtons = force<double, std::ratio<1>>;
@@ -108,6 +108,12 @@ struct make<frequency_dimension, std::milli> {
   using type = millihertz;
 };
 
+template <>
+struct named<frequency_dimension> {
+  using type =
+      unit_list<terahertz, gigahertz, megahertz, kilohertz, hertz, millihertz>;
+};
+
 }  // namespace unit
 
 // Helper aliases
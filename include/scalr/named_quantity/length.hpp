@@ -171,6 +171,14 @@ struct make<length_dimension, std::ratio<254, 10000>> {
   using type = inches;
 };
 
+template <>
+struct named<length_dimension> {
+  using type =
+      unit_list<kilometers, meters, decimeters, centimeters, millimeters,
+                micrometers, nanometers, picometers, miles, yards, feet,
+                inches>;
+};
+
 }  // namespace unit
 
 using kilometers = length<double, std::kilo>;
@@ -79,6 +79,11 @@ struct make<mass_dimension, std::ratio<1, 1000000>> {
   using type = milligrams;
 };
 
+template <>
+struct named<mass_dimension> {
+  using type = unit_list<kilograms, grams, milligrams>;
+};
+
 }  // namespace unit
 
 using kilograms = mass<double, std::ratio<1>>;
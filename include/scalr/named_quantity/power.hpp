@@ -72,6 +72,12 @@ struct gigawatts {
   using dimension = power_dimension;
   using ratio = std::giga;
 };
+
+template <>
+struct named<power_dimension> {
+  using type =
+      unit_list<microwatts, milliwatts, watts, kilowatts, megawatts, gigawatts>;
+};
 }  // namespace unit
 
 using microwatts = power<double, std::micro>;
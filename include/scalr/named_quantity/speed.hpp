@@ -79,6 +79,12 @@ struct make<speed_dimension, std::ratio<1397, 3125>> {
   using type = miles_per_hour;
 };
 
+template <>
+struct named<speed_dimension> {
+  using type =
+      unit_list<meters_per_second, kilometers_per_hour, miles_per_hour>;
+};
+
 }  // namespace unit
 
 using meters_per_second = speed<double, std::ratio<1>>;
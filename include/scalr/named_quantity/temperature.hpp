@@ -59,6 +59,11 @@ struct make<temperature_dimension, Ratio> {
   using type = scalr::temperature_unit<Ratio>;
 };
 
+template <>
+struct named<temperature_dimension> {
+  using type = unit_list<kelvins>;
+};
+
 }  // namespace unit
 
 using kelvins = temperature<double, std::ratio<1>>;
@@ -118,6 +118,13 @@ struct make<time_dimension, std::pico> {
   using type = picoseconds;
 };
 
+template <>
+struct named<time_dimension> {
+  using type =
+      unit_list<hours, minutes, seconds, milliseconds, microseconds,
+                nanoseconds, picoseconds>;
+};
+
 }  // namespace unit
 
 // Helper aliases
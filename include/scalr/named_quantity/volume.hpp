@@ -78,6 +78,11 @@ struct make<volume_dimension, std::micro> {
   using type = milliliters;
 };
 
+template <>
+struct named<volume_dimension> {
+  using type = unit_list<cubic_meters, liters, milliliters>;
+};
+
 }  // namespace unit
 
 using cubic_meters = volume<double, std::ratio<1>>;
@@ -0,0 +1,399 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_OPTIONAL_QUANTITY_HPP
+#define SCALR_OPTIONAL_QUANTITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "scalr/bits.hpp"
+#include "scalr/filter.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/quantity_vector.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Null-aware reductions keep this many independent accumulators
+constexpr std::size_t optional_lanes = 4;
+
+// The value of a representation reserved to mark an empty optional: the
+// lowest signed or the highest unsigned integer
+template <typename Rep, typename = void>
+struct empty_marker {
+  static constexpr Rep value() {
+    return std::is_signed<Rep>::value ? std::numeric_limits<Rep>::lowest()
+                                      : std::numeric_limits<Rep>::max();
+  }
+
+  static bool is(Rep x) { return x == value(); }
+};
+
+// A quiet NaN with payload 1 for floating-point representations. Arithmetic
+// on numbers produces NaNs with an empty payload, so computed NaNs remain
+// values.
+template <typename Rep>
+struct empty_marker<
+    Rep, typename std::enable_if<std::is_floating_point<Rep>::value>::type> {
+  using word = typename std::conditional<sizeof(Rep) == 4, std::uint32_t,
+                                         std::uint64_t>::type;
+  static_assert(sizeof(Rep) == sizeof(word),
+                "optional quantities require 32 or 64-bit floating point");
+
+  static constexpr word bits() {
+    return sizeof(Rep) == 4 ? word(0x7fc00001u) : word(0x7ff8000000000001ull);
+  }
+
+  static Rep value() {
+    const word w = bits();
+    Rep x;
+    std::memcpy(&x, &w, sizeof(x));
+    return x;
+  }
+
+  static bool is(Rep x) {
+    word w;
+    std::memcpy(&w, &x, sizeof(w));
+    return w == bits();
+  }
+};
+
+}  // namespace detail
+
+/* Class template optional quantity
+ *
+ * A quantity<Rep, Unit> or nothing, in the size of Rep. Emptiness is marked
+ * by a reserved value of the representation (see detail::empty_marker), so
+ * that value itself can't be stored: storing it yields an empty optional.
+ */
+template <typename Rep, typename Unit>
+class optional_quantity {
+  using marker = detail::empty_marker<Rep>;
+
+ public:
+  using value_type = quantity<Rep, Unit>;
+
+  optional_quantity() noexcept : value_(marker::value()) {}
+  optional_quantity(const value_type& q) noexcept : value_(q.value()) {}
+
+  template <typename Rep2, typename Unit2,
+            typename std::enable_if<
+                std::is_convertible<quantity<Rep2, Unit2>, value_type>::value,
+                int>::type = 0>
+  optional_quantity(const quantity<Rep2, Unit2>& q) noexcept
+      : value_(value_type(q).value()) {}
+
+  bool has_value() const noexcept { return !marker::is(value_); }
+  explicit operator bool() const noexcept { return has_value(); }
+
+  // The quantity of a nonempty optional
+  value_type operator*() const noexcept { return value_type(value_); }
+
+  value_type value_or(const value_type& q) const noexcept {
+    return has_value() ? value_type(value_) : q;
+  }
+
+  void reset() noexcept { value_ = marker::value(); }
+
+  // The stored representation, the marker if empty
+  Rep raw() const noexcept { return value_; }
+
+ private:
+  Rep value_;
+};
+
+template <typename Rep, typename Unit>
+bool operator==(const optional_quantity<Rep, Unit>& left,
+                const optional_quantity<Rep, Unit>& right) {
+  return left.has_value() == right.has_value() &&
+         (!left.has_value() || *left == *right);
+}
+
+template <typename Rep, typename Unit>
+bool operator!=(const optional_quantity<Rep, Unit>& left,
+                const optional_quantity<Rep, Unit>& right) {
+  return !(left == right);
+}
+
+/* Class template nullable quantity column
+ *
+ * A quantity_vector with a validity bitmap, as in columnar formats: bit i %
+ * 64 of word i / 64 tells whether element i has a value. Empty elements hold
+ * zero, so sums need no mask, and the representation keeps every value.
+ */
+template <typename Rep, typename Unit>
+class nullable_vector {
+ public:
+  using value_type = quantity<Rep, Unit>;
+
+  void push_back(const value_type& q) {
+    append(true);
+    values_.push_back(q);
+  }
+
+  void push_back(const optional_quantity<Rep, Unit>& q) {
+    if (q) {
+      push_back(*q);
+    } else {
+      push_back_null();
+    }
+  }
+
+  void push_back_null() {
+    append(false);
+    values_.push_back(value_type(Rep(0)));
+  }
+
+  std::size_t size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+
+  bool has_value(std::size_t i) const {
+    return (validity_[i / 64] >> (i % 64)) & 1;
+  }
+
+  optional_quantity<Rep, Unit> operator[](std::size_t i) const {
+    return has_value(i) ? optional_quantity<Rep, Unit>(values_[i])
+                        : optional_quantity<Rep, Unit>();
+  }
+
+  const quantity_vector<Rep, Unit>& values() const { return values_; }
+  const std::vector<std::uint64_t>& validity() const { return validity_; }
+
+ private:
+  void append(bool valid) {
+    const std::size_t i = values_.size();
+    if (i % 64 == 0) {
+      validity_.push_back(0);
+    }
+    validity_.back() |= std::uint64_t(valid) << (i % 64);
+  }
+
+  quantity_vector<Rep, Unit> values_;
+  std::vector<std::uint64_t> validity_;
+};
+
+/* Null-aware reductions
+ *
+ * Empty elements are skipped by selecting a neutral value in their place
+ * instead of branching. The loops keep independent lanes, like the
+ * reductions of statistics.hpp, so they pipeline and compilers vectorize the
+ * sums and counts.
+ */
+
+// Number of nonempty optionals in a range
+template <class InputIt>
+std::size_t count_present(InputIt first, InputIt last) {
+  using O = detail::iterator_value_t<InputIt>;
+  std::size_t count = 0;
+  for (; first != last; ++first) {
+    count += O(*first).has_value();
+  }
+  return count;
+}
+
+// Sum of the nonempty optionals in a range
+template <class InputIt>
+typename detail::iterator_value_t<InputIt>::value_type sum_present(
+    InputIt first, InputIt last) {
+  using Q = typename detail::iterator_value_t<InputIt>::value_type;
+  using T = typename Q::value_type;
+  using marker = detail::empty_marker<T>;
+  constexpr std::size_t lanes = detail::optional_lanes;
+  T sum[lanes] = {};
+  auto n = std::distance(first, last);
+  for (; n >= static_cast<decltype(n)>(lanes); n -= lanes) {
+    for (std::size_t i = 0; i < lanes; ++i, ++first) {
+      const T x = (*first).raw();
+      sum[i] += marker::is(x) ? T(0) : x;
+    }
+  }
+  for (; first != last; ++first) {
+    const T x = (*first).raw();
+    sum[0] += marker::is(x) ? T(0) : x;
+  }
+  T total = 0;
+  for (std::size_t i = 0; i < lanes; ++i) {
+    total += sum[i];
+  }
+  return Q(total);
+}
+
+namespace detail {
+
+// Least (Greater = false) or greatest element over lanes, with empty
+// elements replaced by the identity of the reduction
+template <bool Greater, class InputIt>
+iterator_value_t<InputIt> extreme_present(InputIt first, InputIt last) {
+  using O = iterator_value_t<InputIt>;
+  using Q = typename O::value_type;
+  using T = typename Q::value_type;
+  using marker = empty_marker<T>;
+  constexpr std::size_t lanes = optional_lanes;
+  const T identity = std::numeric_limits<T>::has_infinity
+                         ? (Greater ? -std::numeric_limits<T>::infinity()
+                                    : std::numeric_limits<T>::infinity())
+                         : (Greater ? std::numeric_limits<T>::lowest()
+                                    : std::numeric_limits<T>::max());
+  T best[lanes] = {identity, identity, identity, identity};
+  std::size_t count[lanes] = {};
+  auto n = std::distance(first, last);
+  for (; n >= static_cast<decltype(n)>(lanes); n -= lanes) {
+    for (std::size_t i = 0; i < lanes; ++i, ++first) {
+      const T x = (*first).raw();
+      const bool present = !marker::is(x);
+      const T v = present ? x : identity;
+      best[i] = (Greater ? best[i] < v : v < best[i]) ? v : best[i];
+      count[i] += present;
+    }
+  }
+  for (; first != last; ++first) {
+    const T x = (*first).raw();
+    const bool present = !marker::is(x);
+    const T v = present ? x : identity;
+    best[0] = (Greater ? best[0] < v : v < best[0]) ? v : best[0];
+    count[0] += present;
+  }
+  T result = best[0];
+  std::size_t total = count[0];
+  for (std::size_t i = 1; i < lanes; ++i) {
+    result = (Greater ? result < best[i] : best[i] < result) ? best[i] : result;
+    total += count[i];
+  }
+  return total != 0 ? O(Q(result)) : O();
+}
+
+template <bool Greater, typename Rep, typename Unit>
+optional_quantity<Rep, Unit> extreme_present(
+    const nullable_vector<Rep, Unit>& column) {
+  constexpr std::size_t word_bits = 64;
+  const quantity_vector<Rep, Unit>& values = column.values();
+  const std::vector<std::uint64_t>& validity = column.validity();
+  const Rep identity = std::numeric_limits<Rep>::has_infinity
+                           ? (Greater ? -std::numeric_limits<Rep>::infinity()
+                                      : std::numeric_limits<Rep>::infinity())
+                           : (Greater ? std::numeric_limits<Rep>::lowest()
+                                      : std::numeric_limits<Rep>::max());
+  Rep best[word_bits];
+  for (std::size_t i = 0; i < word_bits; ++i) {
+    best[i] = identity;
+  }
+  std::size_t count = 0;
+  for (std::size_t w = 0; w < validity.size(); ++w) {
+    const std::size_t base = w * word_bits;
+    const std::size_t n = values.size() - base < word_bits
+                              ? values.size() - base
+                              : word_bits;
+    const std::uint64_t word = validity[w];
+    count += bit_count(word);
+    for (std::size_t i = 0; i < n; ++i) {
+      const Rep x = ((word >> i) & 1) ? values[base + i].value() : identity;
+      best[i] = (Greater ? best[i] < x : x < best[i]) ? x : best[i];
+    }
+  }
+  Rep result = identity;
+  for (std::size_t i = 0; i < word_bits; ++i) {
+    result = (Greater ? result < best[i] : best[i] < result) ? best[i] : result;
+  }
+  return count ? optional_quantity<Rep, Unit>(quantity<Rep, Unit>(result))
+               : optional_quantity<Rep, Unit>();
+}
+
+}  // namespace detail
+
+// Least of the nonempty optionals in a range, empty if there is none
+template <class InputIt>
+detail::iterator_value_t<InputIt> min_present(InputIt first, InputIt last) {
+  return detail::extreme_present<false>(first, last);
+}
+
+// Greatest of the nonempty optionals in a range, empty if there is none
+template <class InputIt>
+detail::iterator_value_t<InputIt> max_present(InputIt first, InputIt last) {
+  return detail::extreme_present<true>(first, last);
+}
+
+template <typename Rep, typename Unit>
+std::size_t count_present(const nullable_vector<Rep, Unit>& column) {
+  std::size_t count = 0;
+  for (std::uint64_t word : column.validity()) {
+    count += detail::bit_count(word);
+  }
+  return count;
+}
+
+template <typename Rep, typename Unit>
+quantity<Rep, Unit> sum_present(const nullable_vector<Rep, Unit>& column) {
+  constexpr std::size_t lanes = detail::optional_lanes;
+  const quantity_vector<Rep, Unit>& values = column.values();
+  Rep sum[lanes] = {};
+  std::size_t i = 0;
+  for (; i + lanes <= values.size(); i += lanes) {
+    for (std::size_t j = 0; j < lanes; ++j) {
+      sum[j] += values[i + j].value();
+    }
+  }
+  for (; i < values.size(); ++i) {
+    sum[0] += values[i].value();
+  }
+  Rep total = 0;
+  for (std::size_t j = 0; j < lanes; ++j) {
+    total += sum[j];
+  }
+  return quantity<Rep, Unit>(total);
+}
+
+template <typename Rep, typename Unit>
+optional_quantity<Rep, Unit> min_present(
+    const nullable_vector<Rep, Unit>& column) {
+  return detail::extreme_present<false>(column);
+}
+
+template <typename Rep, typename Unit>
+optional_quantity<Rep, Unit> max_present(
+    const nullable_vector<Rep, Unit>& column) {
+  return detail::extreme_present<true>(column);
+}
+
+// Packs the comparison of each element with the threshold into 64-bit words
+// like compare_mask, with the bits of empty elements cleared
+template <typename Rep, typename Unit, class WordIt, typename Rep2,
+          typename Unit2>
+WordIt compare_mask(const nullable_vector<Rep, Unit>& column, WordIt d_first,
+                    comparison op, const quantity<Rep2, Unit2>& threshold) {
+  std::vector<std::uint64_t> mask(column.validity().size());
+  compare_mask(column.values().begin(), column.values().end(), mask.begin(),
+               op, threshold);
+  for (std::size_t w = 0; w < mask.size(); ++w, ++d_first) {
+    *d_first = mask[w] & column.validity()[w];
+  }
+  return d_first;
+}
+
+// Number of nonempty elements that compare true with the threshold
+template <typename Rep, typename Unit, typename Rep2, typename Unit2>
+std::size_t count_if(const nullable_vector<Rep, Unit>& column, comparison op,
+                     const quantity<Rep2, Unit2>& threshold) {
+  std::vector<std::uint64_t> mask(column.validity().size());
+  compare_mask(column, mask.begin(), op, threshold);
+  std::size_t count = 0;
+  for (std::uint64_t word : mask) {
+    count += detail::bit_count(word);
+  }
+  return count;
+}
+
+}  // namespace scalr
+
+#endif
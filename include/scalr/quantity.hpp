@@ -10,11 +10,13 @@
 #ifndef SCALR_QUANTITY_HPP
 #define SCALR_QUANTITY_HPP
 
+#include <cmath>
 #include <limits>
 #include <ratio>
 #include <type_traits>
 
 #include "scalr/dimension.hpp"
+#include "scalr/divider.hpp"
 #include "scalr/unit.hpp"
 
 namespace scalr {
@@ -27,8 +29,8 @@ struct is_quantity : std::false_type {};
 template <typename Rep, typename Unit>
 struct is_quantity<quantity<Rep, Unit>> : std::true_type {};
 
-// TODO: Use this to implement linear/rotational range
-// PLUS: What about Ada-like subtypes?
+// Limits of the representation of a quantity. Narrower, Ada-like subtypes
+// are provided by bounded_quantity.
 template <typename Rep>
 struct linear_range {
   static constexpr Rep zero() noexcept { return Rep(0); }
@@ -45,72 +47,282 @@ struct linear_range {
 // Quantity cast implementation
 // Converts a scalr::quantity to another quantity of the same dimension.
 namespace detail {
+
+// Integral division by the constant denominator goes through a multiply-shift
+// divider and honors the rounding mode; floating division is exact enough.
+template <typename CommonRep, intmax_t Den, rounding Mode,
+          bool = std::is_integral<CommonRep>::value>
+struct ratio_den_divide {
+  static constexpr CommonRep apply(const CommonRep& value) {
+    return value / static_cast<CommonRep>(Den);
+  }
+};
+
+template <typename CommonRep, intmax_t Den, rounding Mode>
+struct ratio_den_divide<CommonRep, Den, Mode, true> {
+  static constexpr CommonRep apply(const CommonRep& value) {
+    return constant_divider<CommonRep, Den>::divide(value, Mode);
+  }
+};
+
+// Rounds to the nearest integer with ties to even, as constant_divider does,
+// whatever the rounding mode of the floating-point environment
+template <typename T>
+T round_half_even(T value) {
+  const T lower = std::floor(value);
+  const T fraction = value - lower;
+  const bool up = fraction > T(0.5) ||
+                  (fraction == T(0.5) && std::fmod(lower, T(2)) != 0);
+  return up ? lower + 1 : lower;
+}
+
+// Conversion of the result to the target representation. Floating results
+// are rounded in the given mode before they are narrowed to an integral
+// representation, which would otherwise truncate them toward zero.
+template <typename TargetRep, typename CommonRep, rounding Mode,
+          bool = std::is_floating_point<CommonRep>::value &&
+                 std::is_integral<TargetRep>::value &&
+                 Mode != rounding::toward_zero>
+struct narrow_rep {
+  static constexpr TargetRep apply(const CommonRep& value) {
+    return static_cast<TargetRep>(value);
+  }
+};
+
+template <typename TargetRep, typename CommonRep, rounding Mode>
+struct narrow_rep<TargetRep, CommonRep, Mode, true> {
+  static TargetRep apply(const CommonRep& value) {
+    return static_cast<TargetRep>(Mode == rounding::downward ? std::floor(value)
+                                  : Mode == rounding::upward
+                                      ? std::ceil(value)
+                                      : round_half_even(value));
+  }
+};
+
 template <typename TargetT, typename CommonRatio, typename CommonRep,
-          bool _NumIsOne = false, bool _DenIsOne = false>
+          bool _NumIsOne = false, bool _DenIsOne = false,
+          rounding _Mode = rounding::toward_zero>
 struct quantity_cast_impl {
   template <typename Rep, typename Unit>
   static constexpr TargetT cast(const quantity<Rep, Unit>& other) {
     using TargetRep = typename TargetT::value_type;
-    return TargetT(
-        static_cast<TargetRep>(static_cast<CommonRep>(other.value()) *
-                               static_cast<CommonRep>(CommonRatio::num) /
-                               static_cast<CommonRep>(CommonRatio::den)));
+    return TargetT(narrow_rep<TargetRep, CommonRep, _Mode>::apply(
+        ratio_den_divide<CommonRep, CommonRatio::den, _Mode>::apply(
+            static_cast<CommonRep>(static_cast<CommonRep>(other.value()) *
+                                   static_cast<CommonRep>(CommonRatio::num)))));
+  }
+};
+
+template <typename TargetT, typename CommonRatio, typename CommonRep,
+          rounding _Mode>
+struct quantity_cast_impl<TargetT, CommonRatio, CommonRep, true, true, _Mode> {
+  template <typename Rep, typename Unit>
+  static constexpr TargetT cast(const quantity<Rep, Unit>& other) {
+    using TargetRep = typename TargetT::value_type;
+    return TargetT(narrow_rep<TargetRep, CommonRep, _Mode>::apply(
+        static_cast<CommonRep>(other.value())));
   }
 };
 
-template <typename TargetT, typename CommonRatio, typename CommonRep>
-struct quantity_cast_impl<TargetT, CommonRatio, CommonRep, true, true> {
+template <typename TargetT, typename CommonRatio, typename CommonRep,
+          rounding _Mode>
+struct quantity_cast_impl<TargetT, CommonRatio, CommonRep, true, false,
+                          _Mode> {
   template <typename Rep, typename Unit>
   static constexpr TargetT cast(const quantity<Rep, Unit>& other) {
     using TargetRep = typename TargetT::value_type;
-    return TargetT(static_cast<TargetRep>(other.value()));
+    return TargetT(narrow_rep<TargetRep, CommonRep, _Mode>::apply(
+        ratio_den_divide<CommonRep, CommonRatio::den, _Mode>::apply(
+            static_cast<CommonRep>(other.value()))));
   }
 };
 
-template <typename TargetT, typename CommonRatio, typename CommonRep>
-struct quantity_cast_impl<TargetT, CommonRatio, CommonRep, true, false> {
+template <typename TargetT, typename CommonRatio, typename CommonRep,
+          rounding _Mode>
+struct quantity_cast_impl<TargetT, CommonRatio, CommonRep, false, true,
+                          _Mode> {
   template <typename Rep, typename Unit>
   static constexpr TargetT cast(const quantity<Rep, Unit>& other) {
     using TargetRep = typename TargetT::value_type;
-    return TargetT(
-        static_cast<TargetRep>(static_cast<CommonRep>(other.value()) /
-                               static_cast<CommonRep>(CommonRatio::den)));
+    return TargetT(narrow_rep<TargetRep, CommonRep, _Mode>::apply(
+        static_cast<CommonRep>(other.value()) *
+        static_cast<CommonRep>(CommonRatio::num)));
   }
 };
 
-template <typename TargetT, typename CommonRatio, typename CommonRep>
-struct quantity_cast_impl<TargetT, CommonRatio, CommonRep, false, true> {
+// Whether every value of From scaled by K is representable in To
+template <typename From, typename To>
+constexpr bool scaled_range_fits(wide_int k) {
+  return std::is_integral<From>::value && std::is_integral<To>::value &&
+         static_cast<wide_uint>(std::numeric_limits<To>::max()) /
+                 static_cast<wide_uint>(std::numeric_limits<From>::max()) >=
+             static_cast<wide_uint>(k) &&
+         (std::numeric_limits<From>::lowest() == 0 ||
+          (std::is_signed<To>::value &&
+           static_cast<wide_int>(std::numeric_limits<To>::lowest()) /
+                   static_cast<wide_int>(
+                       std::numeric_limits<From>::lowest()) >=
+               k));
+}
+
+// Conversion factors beyond the range of std::ratio, for example between
+// exa- and atto-units, and factors involving powers of pi are applied as a
+// single floating multiply by a constant rounded once from long double
+template <typename TargetT, typename WideRatio, intmax_t Pi,
+          typename CommonRep, rounding Mode = rounding::toward_zero>
+struct quantity_cast_wide_impl {
+  static_assert(std::is_floating_point<CommonRep>::value,
+                "conversion factor is out of the range of integral quantities");
+
+  static constexpr CommonRep factor() {
+    return static_cast<CommonRep>(static_cast<long double>(WideRatio::num) /
+                                  static_cast<long double>(WideRatio::den) *
+                                  pi_power(Pi));
+  }
+
   template <typename Rep, typename Unit>
   static constexpr TargetT cast(const quantity<Rep, Unit>& other) {
     using TargetRep = typename TargetT::value_type;
-    return TargetT(
-        static_cast<TargetRep>(static_cast<CommonRep>(other.value()) *
-                               static_cast<CommonRep>(CommonRatio::num)));
+    return TargetT(narrow_rep<TargetRep, CommonRep, Mode>::apply(
+        static_cast<CommonRep>(other.value()) * factor()));
   }
 };
 
+template <typename TargetT, typename WideRatio, intmax_t Pi,
+          typename CommonRep, rounding Mode,
+          bool = (Pi == 0) && wide_ratio_fits<WideRatio>::value>
+struct quantity_cast_select {
+  using common_factor = wide_ratio_narrow_t<WideRatio>;
+  using type =
+      quantity_cast_impl<TargetT, common_factor, CommonRep,
+                         common_factor::num == 1, common_factor::den == 1,
+                         Mode>;
+};
+
+template <typename TargetT, typename WideRatio, intmax_t Pi,
+          typename CommonRep, rounding Mode>
+struct quantity_cast_select<TargetT, WideRatio, Pi, CommonRep, Mode, false> {
+  using type =
+      quantity_cast_wide_impl<TargetT, WideRatio, Pi, CommonRep, Mode>;
+};
+
+}  // namespace detail
+
+namespace quantity_type {
+
+// The arithmetic type of quantity_cast from Source to Target. Integral
+// conversions stay in the wider of the two reps, or their common type, if
+// the source range scaled by the factor numerator provably fits; the
+// division by the denominator only shrinks values. Otherwise (and for
+// floating reps) the conversion is done in intmax_t as in std::chrono.
+template <typename Target, typename Source>
+struct cast {
+  using factor = detail::wide_ratio_divide_t<typename Source::ratio,
+                                             typename Target::ratio>;
+  static constexpr intmax_t pi = Source::pi - Target::pi;
+
+  using V1 = typename Source::value_type;
+  using V2 = typename Target::value_type;
+  using wider_value_type =
+      typename std::conditional<(sizeof(V2) > sizeof(V1)), V2, V1>::type;
+  using common_value_type = typename std::common_type<V1, V2>::type;
+  using widened_value_type = typename std::common_type<V1, V2, intmax_t>::type;
+
+  using value_type = typename std::conditional<
+      detail::scaled_range_fits<V1, wider_value_type>(factor::num),
+      wider_value_type,
+      typename std::conditional<
+          detail::scaled_range_fits<V1, common_value_type>(factor::num),
+          common_value_type, widened_value_type>::type>::type;
+
+  static constexpr bool is_narrow =
+      !std::is_same<value_type, widened_value_type>::value;
+};
+
+}  // namespace quantity_type
+
+template <class Target, class Source>
+using quantity_cast_value_t =
+    typename quantity_type::cast<Target, Source>::value_type;
+
+namespace detail {
+
+template <class Target, rounding Mode, class Rep2, class Unit2>
+constexpr Target rounded_quantity_cast(const quantity<Rep2, Unit2>& other) {
+  using traits = quantity_type::cast<Target, quantity<Rep2, Unit2>>;
+  using implementation =
+      typename quantity_cast_select<Target, typename traits::factor,
+                                    traits::pi, typename traits::value_type,
+                                    Mode>::type;
+
+  return implementation::cast(other);
+}
+
 }  // namespace detail
 
 template <typename T>
 using enable_if_is_quantity =
     typename std::enable_if<is_quantity<T>::value, T>::type;
 
+// Truncates toward zero like integer division
 template <class Target, class Rep2, class Unit2>
 constexpr enable_if_is_quantity<Target> quantity_cast(
     const quantity<Rep2, Unit2>& other) {
-  using common_factor =
-      std::ratio_divide<typename Unit2::ratio, typename Target::ratio>;
+  return detail::rounded_quantity_cast<Target, rounding::toward_zero>(other);
+}
 
-  using TargetRep = typename Target::value_type;
-  using common_value_t =
-      typename std::common_type<Rep2, TargetRep, intmax_t>::type;
+// Rounding variants of quantity_cast similar to std::chrono::floor, ceil and
+// round. Ties round to even. Conversions to floating representations are not
+// rounded.
+template <class Target, class Rep2, class Unit2>
+constexpr enable_if_is_quantity<Target> floor(
+    const quantity<Rep2, Unit2>& other) {
+  return detail::rounded_quantity_cast<Target, rounding::downward>(other);
+}
 
-  using implementation =
-      detail::quantity_cast_impl<Target, common_factor, common_value_t,
-                                 common_factor::num == 1,
-                                 common_factor::den == 1>;
+template <class Target, class Rep2, class Unit2>
+constexpr enable_if_is_quantity<Target> ceil(
+    const quantity<Rep2, Unit2>& other) {
+  return detail::rounded_quantity_cast<Target, rounding::upward>(other);
+}
 
-  return implementation::cast(other);
+template <class Target, class Rep2, class Unit2>
+constexpr enable_if_is_quantity<Target> round(
+    const quantity<Rep2, Unit2>& other) {
+  return detail::rounded_quantity_cast<Target, rounding::to_nearest>(other);
+}
+
+// Batch conversions over ranges of quantities
+template <class Target, class InputIt, class OutputIt>
+OutputIt quantity_cast(InputIt first, InputIt last, OutputIt d_first) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = quantity_cast<Target>(*first);
+  }
+  return d_first;
+}
+
+template <class Target, class InputIt, class OutputIt>
+OutputIt floor(InputIt first, InputIt last, OutputIt d_first) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = floor<Target>(*first);
+  }
+  return d_first;
+}
+
+template <class Target, class InputIt, class OutputIt>
+OutputIt ceil(InputIt first, InputIt last, OutputIt d_first) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = ceil<Target>(*first);
+  }
+  return d_first;
+}
+
+template <class Target, class InputIt, class OutputIt>
+OutputIt round(InputIt first, InputIt last, OutputIt d_first) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = round<Target>(*first);
+  }
+  return d_first;
 }
 
 //******************************
@@ -122,7 +334,8 @@ struct quantity {
   using value_type = Rep;
   using dimension = typename Unit::dimension;
   using ratio = typename Unit::ratio;
-  using unit = make_unit_t<dimension, ratio>;
+  static constexpr intmax_t pi = detail::unit_pi<Unit>::value;
+  using unit = make_unit_t<dimension, ratio, pi>;
 
   using type = quantity<value_type, unit>;
 
@@ -151,8 +364,10 @@ struct quantity {
                 std::is_same<typename Unit2::dimension, dimension>::value &&
                     (std::is_floating_point<value_type>::value ||
                      (std::integral_constant<
-                          bool, std::ratio_divide<typename Unit2::ratio,
-                                                  ratio>::den == 1>::value &&
+                          bool, detail::wide_ratio_divide_t<
+                                    typename Unit2::ratio, ratio>::den ==
+                                    1>::value &&
+                      detail::unit_pi<Unit2>::value == pi &&
                       !std::is_floating_point<Rep2>::value)),
                 int>::type = 0>
   constexpr quantity(const quantity<Rep2, Unit2>& other)
@@ -214,6 +429,9 @@ struct quantity {
   value_type value_;
 };
 
+template <typename Rep, typename Unit>
+constexpr intmax_t quantity<Rep, Unit>::pi;
+
 namespace quantity_type {
 
 template <typename Q1>
@@ -258,19 +476,85 @@ using quantity_sum_t = typename quantity_type::sum<Q1, Qn...>::type;
 template <class Q1, class... Qn>
 using quantity_product_t = typename quantity_type::product<Q1, Qn...>::type;
 
+// Mixed-unit operands
+// Two quantities of the same dimension are related by the reduced ratio a/b
+// between their units, so (left * a) and (right * b) are values in the common
+// unit of quantity_sum_t. Scaling by these integer factors needs no division
+// and leaves the operand of the finer unit untouched whenever one unit ratio
+// divides the other (a or b is then one). Integral operands are scaled in
+// intmax_t as in quantity_cast.
+namespace detail {
+
+template <wide_int K, typename T>
+constexpr T scale_by(const T& value) {
+  return K == 1 ? value : static_cast<T>(value * static_cast<T>(K));
+}
+
+template <typename Q1, typename Q2, bool = (Q1::pi == Q2::pi)>
+struct quantity_cross {
+  static_assert(std::is_same<typename Q1::dimension,
+                             typename Q2::dimension>::value,
+                "unit dimensions must match for mixed-unit operations");
+
+  using factor =
+      wide_ratio_divide_t<typename Q1::ratio, typename Q2::ratio>;
+  using value_type =
+      typename std::common_type<typename Q1::value_type,
+                                typename Q2::value_type, intmax_t>::type;
+
+  static_assert(std::is_floating_point<value_type>::value ||
+                    wide_ratio_fits<factor>::value,
+                "unit ratios are too far apart for integral quantities");
+
+  static constexpr value_type left(const Q1& q) {
+    return scale_by<factor::num>(static_cast<value_type>(q.value()));
+  }
+
+  static constexpr value_type right(const Q2& q) {
+    return scale_by<factor::den>(static_cast<value_type>(q.value()));
+  }
+};
+
+// Units differing by a power of pi have no common rational unit, so the right
+// operand is converted to the unit of the left one
+template <typename Q1, typename Q2>
+struct quantity_cross<Q1, Q2, false> {
+  static_assert(std::is_same<typename Q1::dimension,
+                             typename Q2::dimension>::value,
+                "unit dimensions must match for mixed-unit operations");
+
+  using value_type =
+      typename std::common_type<typename Q1::value_type,
+                                typename Q2::value_type, intmax_t>::type;
+  using converter = quantity_cast_wide_impl<
+      quantity<value_type, typename Q1::unit>,
+      wide_ratio_divide_t<typename Q2::ratio, typename Q1::ratio>,
+      Q2::pi - Q1::pi, value_type>;
+
+  static constexpr value_type left(const Q1& q) {
+    return static_cast<value_type>(q.value());
+  }
+
+  static constexpr value_type right(const Q2& q) {
+    return converter::cast(q).value();
+  }
+};
+
+}  // namespace detail
+
 // Comparison operators
 template <typename T1, typename U1, typename T2, typename U2>
 constexpr bool operator==(const quantity<T1, U1>& left,
                           const quantity<T2, U2>& right) {
-  using stype = quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>;
-  return stype(left).value() == stype(right).value();
+  using cross = detail::quantity_cross<quantity<T1, U1>, quantity<T2, U2>>;
+  return cross::left(left) == cross::right(right);
 }
 
 template <typename T1, typename U1, typename T2, typename U2>
 constexpr bool operator<(const quantity<T1, U1>& left,
                          const quantity<T2, U2>& right) {
-  using stype = quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>;
-  return stype(left).value() < stype(right).value();
+  using cross = detail::quantity_cross<quantity<T1, U1>, quantity<T2, U2>>;
+  return cross::left(left) < cross::right(right);
 }
 
 template <typename T1, typename U1, typename T2, typename U2>
@@ -306,7 +590,8 @@ constexpr quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>> operator+(
       std::is_same<typename U1::dimension, typename U2::dimension>::value,
       "unit dimensions must match for addition");
   using stype = quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>;
-  return stype(stype(left).value() + stype(right).value());
+  using cross = detail::quantity_cross<quantity<T1, U1>, quantity<T2, U2>>;
+  return stype(cross::left(left) + cross::right(right));
 }
 
 // The difference between two physical quantities having the same dimension
@@ -317,7 +602,8 @@ constexpr quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>> operator-(
       std::is_same<typename U1::dimension, typename U2::dimension>::value,
       "unit dimensions must match for subtraction");
   using stype = quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>;
-  return stype(stype(left).value() - stype(right).value());
+  using cross = detail::quantity_cross<quantity<T1, U1>, quantity<T2, U2>>;
+  return stype(cross::left(left) - cross::right(right));
 }
 
 // The multiplication by scalar
@@ -392,8 +678,8 @@ template <typename T1, typename U1, typename T2, typename U2,
 constexpr typename std::common_type<T1, T2>::type operator/(
     const quantity<T1, U1>& left, const quantity<T2, U2>& right) {
   using vtype = typename std::common_type<T1, T2>::type;
-  using stype = quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>;
-  return vtype(stype(left).value() / stype(right).value());
+  using cross = detail::quantity_cross<quantity<T1, U1>, quantity<T2, U2>>;
+  return vtype(cross::left(left) / cross::right(right));
 }
 
 // The modulo between two physical quantities having the same dimension
@@ -0,0 +1,397 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_QUANTITY_VEC_HPP
+#define SCALR_QUANTITY_VEC_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "scalr/math.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+namespace detail {
+
+constexpr std::size_t ceil_pow2(std::size_t n, std::size_t p = 1) {
+  return p >= n ? p : ceil_pow2(n, 2 * p);
+}
+
+// Vectors are aligned to their size rounded up to a power of two, so that a
+// vec3 of doubles occupies and aligns like a vec4. The alignment is capped at
+// that of std::max_align_t, which operator new guarantees before C++17.
+constexpr std::size_t vec_alignment(std::size_t size) {
+  return ceil_pow2(size) < alignof(std::max_align_t)
+             ? ceil_pow2(size)
+             : alignof(std::max_align_t);
+}
+
+}  // namespace detail
+
+/* Class template fixed-size vector of quantities
+ *
+ * All N components share the representation and the unit, so the vector is
+ * N contiguous values of Rep. Arithmetic is componentwise and follows the
+ * unit rules of scalar quantities.
+ */
+template <typename Rep, typename Unit, std::size_t N>
+struct alignas(detail::vec_alignment(sizeof(Rep) * N)) quantity_vec {
+  using value_type = quantity<Rep, Unit>;
+  using rep = Rep;
+  using unit = typename value_type::unit;
+  using dimension = typename value_type::dimension;
+
+  static_assert(N > 0, "quantity_vec must have at least one component");
+
+  quantity_vec() = default;
+
+  // One quantity per component, each converted to the unit of the vector.
+  // Explicit so that neither a brace list nor, for N = 1, a lone quantity
+  // converts to a vector silently.
+  template <typename... Qn,
+            typename std::enable_if<sizeof...(Qn) == N, int>::type = 0>
+  constexpr explicit quantity_vec(const Qn&... components)
+      : data_{value_type(components)...} {}
+
+  static constexpr std::size_t size() { return N; }
+
+  value_type& operator[](std::size_t i) { return data_[i]; }
+  constexpr const value_type& operator[](std::size_t i) const {
+    return data_[i];
+  }
+
+  constexpr const value_type& x() const { return data_[0]; }
+  constexpr const value_type& y() const {
+    static_assert(N > 1, "y() requires at least two components");
+    return data_[1];
+  }
+
+  constexpr const value_type& z() const {
+    static_assert(N > 2, "z() requires at least three components");
+    return data_[2];
+  }
+
+  constexpr const value_type& w() const {
+    static_assert(N > 3, "w() requires four components");
+    return data_[3];
+  }
+
+  quantity_vec operator-() const {
+    quantity_vec result;
+    for (std::size_t i = 0; i < N; ++i) {
+      result.data_[i] = -data_[i];
+    }
+    return result;
+  }
+
+  quantity_vec& operator+=(const quantity_vec& other) {
+    for (std::size_t i = 0; i < N; ++i) {
+      data_[i] += other.data_[i];
+    }
+    return *this;
+  }
+
+  quantity_vec& operator-=(const quantity_vec& other) {
+    for (std::size_t i = 0; i < N; ++i) {
+      data_[i] -= other.data_[i];
+    }
+    return *this;
+  }
+
+  quantity_vec& operator*=(const Rep& factor) {
+    for (std::size_t i = 0; i < N; ++i) {
+      data_[i] *= factor;
+    }
+    return *this;
+  }
+
+  quantity_vec& operator/=(const Rep& factor) {
+    for (std::size_t i = 0; i < N; ++i) {
+      data_[i] /= factor;
+    }
+    return *this;
+  }
+
+ private:
+  value_type data_[N];
+};
+
+template <typename Rep, typename Unit>
+using quantity_vec2 = quantity_vec<Rep, Unit, 2>;
+
+template <typename Rep, typename Unit>
+using quantity_vec3 = quantity_vec<Rep, Unit, 3>;
+
+template <typename Rep, typename Unit>
+using quantity_vec4 = quantity_vec<Rep, Unit, 4>;
+
+namespace detail {
+
+// The vector type holding quantities of type Q
+template <typename Q, std::size_t N>
+using quantity_vec_of =
+    quantity_vec<typename Q::value_type, typename Q::unit, N>;
+
+template <typename Result, std::size_t N, typename V1, typename V2,
+          typename Op>
+Result componentwise(const V1& a, const V2& b, Op op) {
+  Result result;
+  for (std::size_t i = 0; i < N; ++i) {
+    result[i] = op(a[i], b[i]);
+  }
+  return result;
+}
+
+struct plus_op {
+  template <typename Q1, typename Q2>
+  constexpr auto operator()(const Q1& a, const Q2& b) const
+      -> decltype(a + b) {
+    return a + b;
+  }
+};
+
+struct minus_op {
+  template <typename Q1, typename Q2>
+  constexpr auto operator()(const Q1& a, const Q2& b) const
+      -> decltype(a - b) {
+    return a - b;
+  }
+};
+
+}  // namespace detail
+
+// Componentwise sum and difference of vectors of the same dimension
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+detail::quantity_vec_of<quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>, N>
+operator+(const quantity_vec<T1, U1, N>& a, const quantity_vec<T2, U2, N>& b) {
+  using result_type = detail::quantity_vec_of<
+      quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>, N>;
+  return detail::componentwise<result_type, N>(a, b, detail::plus_op());
+}
+
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+detail::quantity_vec_of<quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>, N>
+operator-(const quantity_vec<T1, U1, N>& a, const quantity_vec<T2, U2, N>& b) {
+  using result_type = detail::quantity_vec_of<
+      quantity_sum_t<quantity<T1, U1>, quantity<T2, U2>>, N>;
+  return detail::componentwise<result_type, N>(a, b, detail::minus_op());
+}
+
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+bool operator==(const quantity_vec<T1, U1, N>& a,
+                const quantity_vec<T2, U2, N>& b) {
+  for (std::size_t i = 0; i < N; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+bool operator!=(const quantity_vec<T1, U1, N>& a,
+                const quantity_vec<T2, U2, N>& b) {
+  return !(a == b);
+}
+
+// Scaling by a number or a quantity
+template <typename S, typename Rep, typename Unit, std::size_t N,
+          typename std::enable_if<std::is_arithmetic<S>::value, int>::type = 0>
+quantity_vec<typename std::common_type<S, Rep>::type, Unit, N> operator*(
+    const S& factor, const quantity_vec<Rep, Unit, N>& v) {
+  quantity_vec<typename std::common_type<S, Rep>::type, Unit, N> result;
+  for (std::size_t i = 0; i < N; ++i) {
+    result[i] = v[i] * factor;
+  }
+  return result;
+}
+
+template <typename S, typename Rep, typename Unit, std::size_t N,
+          typename std::enable_if<std::is_arithmetic<S>::value, int>::type = 0>
+quantity_vec<typename std::common_type<S, Rep>::type, Unit, N> operator*(
+    const quantity_vec<Rep, Unit, N>& v, const S& factor) {
+  return factor * v;
+}
+
+template <typename S, typename Rep, typename Unit, std::size_t N,
+          typename std::enable_if<std::is_arithmetic<S>::value, int>::type = 0>
+quantity_vec<typename std::common_type<S, Rep>::type, Unit, N> operator/(
+    const quantity_vec<Rep, Unit, N>& v, const S& factor) {
+  quantity_vec<typename std::common_type<S, Rep>::type, Unit, N> result;
+  for (std::size_t i = 0; i < N; ++i) {
+    result[i] = v[i] / factor;
+  }
+  return result;
+}
+
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+detail::quantity_vec_of<
+    quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>, N>
+operator*(const quantity<T1, U1>& factor, const quantity_vec<T2, U2, N>& v) {
+  detail::quantity_vec_of<
+      quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>, N>
+      result;
+  for (std::size_t i = 0; i < N; ++i) {
+    result[i] = factor * v[i];
+  }
+  return result;
+}
+
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+detail::quantity_vec_of<
+    quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>, N>
+operator*(const quantity_vec<T1, U1, N>& v, const quantity<T2, U2>& factor) {
+  detail::quantity_vec_of<
+      quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>, N>
+      result;
+  for (std::size_t i = 0; i < N; ++i) {
+    result[i] = v[i] * factor;
+  }
+  return result;
+}
+
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+detail::quantity_vec_of<
+    quantity_product_t<quantity<T1, U1>, quantity_inverse_t<quantity<T2, U2>>>,
+    N>
+operator/(const quantity_vec<T1, U1, N>& v, const quantity<T2, U2>& divisor) {
+  using Q = quantity_product_t<quantity<T1, U1>,
+                               quantity_inverse_t<quantity<T2, U2>>>;
+  detail::quantity_vec_of<Q, N> result;
+  for (std::size_t i = 0; i < N; ++i) {
+    result[i] = Q(v[i].value() / divisor.value());
+  }
+  return result;
+}
+
+// Dot product in the product unit of the components
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N>
+quantity_product_t<quantity<T1, U1>, quantity<T2, U2>> dot(
+    const quantity_vec<T1, U1, N>& a, const quantity_vec<T2, U2, N>& b) {
+  using Q = quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>;
+  typename Q::value_type sum = a[0].value() * b[0].value();
+  for (std::size_t i = 1; i < N; ++i) {
+    sum += a[i].value() * b[i].value();
+  }
+  return Q(sum);
+}
+
+// Cross product of three-dimensional vectors
+template <typename T1, typename U1, typename T2, typename U2>
+detail::quantity_vec_of<
+    quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>, 3>
+cross(const quantity_vec<T1, U1, 3>& a, const quantity_vec<T2, U2, 3>& b) {
+  return detail::quantity_vec_of<
+      quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>, 3>(
+      a.y() * b.z() - a.z() * b.y(), a.z() * b.x() - a.x() * b.z(),
+      a.x() * b.y() - a.y() * b.x());
+}
+
+// Euclidean norm in the unit of the components
+template <typename Rep, typename Unit, std::size_t N>
+quantity<detail::floating_value_t<Rep>, Unit> norm(
+    const quantity_vec<Rep, Unit, N>& v) {
+  using F = detail::floating_value_t<Rep>;
+  F sum = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    sum += static_cast<F>(v[i].value()) * static_cast<F>(v[i].value());
+  }
+  return quantity<F, Unit>(std::sqrt(sum));
+}
+
+/* Array-of-structs-of-arrays layout of quantity vectors
+ *
+ * Vectors are stored in blocks of Lanes vectors where every component is a
+ * contiguous array of Lanes values. Batch kernels iterate over blocks,
+ * components and lanes, and the innermost loop over lanes maps to packed
+ * instructions. The last block is padded with zeros.
+ */
+template <typename Rep, typename Unit, std::size_t N, std::size_t Lanes = 8>
+class quantity_vec_array {
+ public:
+  using value_type = quantity_vec<Rep, Unit, N>;
+  using quantity_type = quantity<Rep, Unit>;
+
+  struct alignas(detail::vec_alignment(sizeof(Rep) * Lanes)) block {
+    Rep values[N][Lanes];
+  };
+
+  static constexpr std::size_t lanes = Lanes;
+
+  explicit quantity_vec_array(std::size_t size = 0) { resize(size); }
+
+  std::size_t size() const { return size_; }
+
+  void resize(std::size_t size) {
+    blocks_.resize((size + Lanes - 1) / Lanes, block());
+    size_ = size;
+  }
+
+  value_type get(std::size_t i) const {
+    value_type result;
+    for (std::size_t c = 0; c < N; ++c) {
+      result[c] = quantity_type(blocks_[i / Lanes].values[c][i % Lanes]);
+    }
+    return result;
+  }
+
+  void set(std::size_t i, const value_type& v) {
+    for (std::size_t c = 0; c < N; ++c) {
+      blocks_[i / Lanes].values[c][i % Lanes] = v[c].value();
+    }
+  }
+
+  block* blocks() { return blocks_.data(); }
+  const block* blocks() const { return blocks_.data(); }
+  std::size_t block_count() const { return blocks_.size(); }
+
+ private:
+  std::vector<block> blocks_;
+  std::size_t size_ = 0;
+};
+
+// Scales each vector by the scalar quantity of the same index, for example
+// forces from masses and accelerations. Scalars are read from a contiguous
+// range of at least v.size() quantities.
+template <typename T1, typename U1, typename T2, typename U2, std::size_t N,
+          std::size_t Lanes>
+quantity_vec_array<
+    typename quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>::value_type,
+    typename quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>::unit, N,
+    Lanes>
+multiply(const quantity<T1, U1>* scalars,
+         const quantity_vec_array<T2, U2, N, Lanes>& v) {
+  using Q = quantity_product_t<quantity<T1, U1>, quantity<T2, U2>>;
+  quantity_vec_array<typename Q::value_type, typename Q::unit, N, Lanes>
+      result(v.size());
+
+  const std::size_t full = v.size() / Lanes;
+  for (std::size_t b = 0; b < full; ++b) {
+    for (std::size_t c = 0; c < N; ++c) {
+      for (std::size_t l = 0; l < Lanes; ++l) {
+        result.blocks()[b].values[c][l] =
+            scalars[b * Lanes + l].value() * v.blocks()[b].values[c][l];
+      }
+    }
+  }
+  for (std::size_t c = 0; c < N; ++c) {
+    for (std::size_t l = 0; l < v.size() % Lanes; ++l) {
+      result.blocks()[full].values[c][l] =
+          scalars[full * Lanes + l].value() * v.blocks()[full].values[c][l];
+    }
+  }
+  return result;
+}
+
+}  // namespace scalr
+
+#endif
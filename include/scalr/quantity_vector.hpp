@@ -0,0 +1,39 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_QUANTITY_VECTOR_HPP
+#define SCALR_QUANTITY_VECTOR_HPP
+
+#include <iterator>
+#include <vector>
+
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+
+/* Contiguous array of quantities of one type
+ *
+ * A quantity holds nothing but its value, so a quantity_vector has the memory
+ * layout of an array of Rep. Struct-of-arrays state is a set of
+ * quantity_vectors, one per physical field, which loops traverse with unit
+ * stride and compilers vectorize as if they were raw arrays.
+ */
+template <typename Rep, typename Unit>
+using quantity_vector = std::vector<quantity<Rep, Unit>>;
+
+namespace detail {
+
+template <typename It>
+using iterator_value_t = typename std::iterator_traits<It>::value_type;
+
+}  // namespace detail
+
+}  // namespace scalr
+
+#endif
@@ -9,9 +9,15 @@
  */
 
 // Core
+#include "scalr/bounded_quantity.hpp"
 #include "scalr/dimension.hpp"
+#include "scalr/divider.hpp"
+#include "scalr/optional_quantity.hpp"
 #include "scalr/quantity.hpp"
+#include "scalr/quantity_vec.hpp"
+#include "scalr/quantity_vector.hpp"
 #include "scalr/unit.hpp"
+#include "scalr/unit_table.hpp"
 // Named quantities
 #include "scalr/named_quantity/acceleration.hpp"
 #include "scalr/named_quantity/amount_of_substance.hpp"
@@ -24,6 +30,7 @@
 #include "scalr/named_quantity/crackle.hpp"
 #include "scalr/named_quantity/electric_current.hpp"
 #include "scalr/named_quantity/electric_potential.hpp"
+#include "scalr/named_quantity/energy.hpp"
 #include "scalr/named_quantity/force.hpp"
 #include "scalr/named_quantity/frequency.hpp"
 #include "scalr/named_quantity/jerk.hpp"
@@ -38,3 +45,21 @@
 #include "scalr/named_quantity/temperature.hpp"
 #include "scalr/named_quantity/time.hpp"
 #include "scalr/named_quantity/volume.hpp"
+// Functions
+#include "scalr/atomic.hpp"
+#include "scalr/bam.hpp"
+#include "scalr/calculus.hpp"
+#include "scalr/compact.hpp"
+#include "scalr/compressed_series.hpp"
+#include "scalr/filter.hpp"
+#include "scalr/histogram.hpp"
+#include "scalr/integrator.hpp"
+#include "scalr/join.hpp"
+#include "scalr/lut.hpp"
+#include "scalr/math.hpp"
+#include "scalr/statistics.hpp"
+#include "scalr/trigonometry.hpp"
+#include "scalr/tsc_clock.hpp"
+#include "scalr/window.hpp"
+// Constants
+#include "scalr/constant.hpp"
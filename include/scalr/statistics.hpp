@@ -0,0 +1,249 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_STATISTICS_HPP
+#define SCALR_STATISTICS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "scalr/math.hpp"
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Number of independent accumulators in batch updates. Sums over separate
+// lanes have no loop-carried dependency on each other, so they pipeline and
+// vectorize without reassociating floating-point additions.
+constexpr std::size_t statistics_lanes = 4;
+
+}  // namespace detail
+
+/* Class template streaming mean and variance of a quantity stream
+ *
+ * Samples are accumulated in a single pass with Welford's update and kept in
+ * the unit of Q with a floating-point representation. Two accumulators over
+ * disjoint streams merge into the accumulator of the joint stream, so streams
+ * may be split across threads and combined afterwards. The variance is in
+ * the square of the unit of Q.
+ */
+template <typename Q>
+class running_moments {
+ public:
+  using value_type = detail::floating_value_t<typename Q::value_type>;
+  using mean_type = quantity<value_type, typename Q::unit>;
+  using variance_type = quantity_product_t<mean_type, mean_type>;
+
+  constexpr running_moments() : count_(0), mean_(0), m2_(0) {}
+
+  template <typename Rep, typename Unit>
+  void push(const quantity<Rep, Unit>& sample) {
+    const value_type x = mean_type(sample).value();
+    const value_type delta = x - mean_;
+    ++count_;
+    mean_ += delta / static_cast<value_type>(count_);
+    m2_ += delta * (x - mean_);
+  }
+
+  // Accumulates a range of samples with shifted sums over independent lanes
+  // and merges them in one step
+  template <class InputIt>
+  void push(InputIt first, InputIt last) {
+    constexpr std::size_t lanes = detail::statistics_lanes;
+    if (first == last) {
+      return;
+    }
+
+    const value_type shift = count_ ? mean_ : mean_type(*first).value();
+    value_type sum[lanes] = {};
+    value_type squares[lanes] = {};
+    std::size_t n = 0;
+    while (first != last) {
+      // Lanes past the end of the range hold zero deviations and add nothing
+      value_type d[lanes] = {};
+      for (std::size_t i = 0; i < lanes && first != last; ++i, ++first, ++n) {
+        d[i] = mean_type(*first).value() - shift;
+      }
+      for (std::size_t i = 0; i < lanes; ++i) {
+        sum[i] += d[i];
+        squares[i] += d[i] * d[i];
+      }
+    }
+
+    value_type s1 = 0;
+    value_type s2 = 0;
+    for (std::size_t i = 0; i < lanes; ++i) {
+      s1 += sum[i];
+      s2 += squares[i];
+    }
+    const value_type block_mean = s1 / static_cast<value_type>(n);
+    merge(n, shift + block_mean, s2 - s1 * block_mean);
+  }
+
+  // Combines with an accumulator over a disjoint stream
+  void merge(const running_moments& other) {
+    merge(other.count_, other.mean_, other.m2_);
+  }
+
+  std::size_t count() const { return count_; }
+
+  mean_type mean() const { return mean_type(mean_); }
+
+  // Population variance of the samples
+  variance_type variance() const {
+    return variance_type(m2_ / static_cast<value_type>(count_));
+  }
+
+  // Unbiased variance estimate with Bessel's correction
+  variance_type sample_variance() const {
+    return variance_type(m2_ / static_cast<value_type>(count_ - 1));
+  }
+
+  mean_type stddev() const {
+    return mean_type(std::sqrt(m2_ / static_cast<value_type>(count_)));
+  }
+
+ private:
+  void merge(std::size_t count, value_type mean, value_type m2) {
+    if (count == 0) {
+      return;
+    }
+    const std::size_t total = count_ + count;
+    const value_type weight =
+        static_cast<value_type>(count) / static_cast<value_type>(total);
+    const value_type delta = mean - mean_;
+    mean_ += delta * weight;
+    m2_ += m2 + delta * delta * static_cast<value_type>(count_) * weight;
+    count_ = total;
+  }
+
+  std::size_t count_;
+  value_type mean_;
+  value_type m2_;
+};
+
+/* Class template streaming covariance of paired quantity streams
+ *
+ * The covariance of X and Y samples is in the product of their units and may
+ * have a dimension of its own, as the covariance of force and displacement
+ * has the dimension of energy.
+ */
+template <typename QX, typename QY>
+class running_covariance {
+ public:
+  using value_type = detail::floating_value_t<typename std::common_type<
+      typename QX::value_type, typename QY::value_type>::type>;
+  using x_mean_type = quantity<value_type, typename QX::unit>;
+  using y_mean_type = quantity<value_type, typename QY::unit>;
+  using covariance_type = quantity_product_t<x_mean_type, y_mean_type>;
+
+  constexpr running_covariance()
+      : count_(0), x_mean_(0), y_mean_(0), c_(0) {}
+
+  template <typename T1, typename U1, typename T2, typename U2>
+  void push(const quantity<T1, U1>& x, const quantity<T2, U2>& y) {
+    const value_type u = x_mean_type(x).value();
+    const value_type v = y_mean_type(y).value();
+    const value_type dx = u - x_mean_;
+    ++count_;
+    x_mean_ += dx / static_cast<value_type>(count_);
+    y_mean_ += (v - y_mean_) / static_cast<value_type>(count_);
+    c_ += dx * (v - y_mean_);
+  }
+
+  template <class InputIt1, class InputIt2>
+  void push(InputIt1 x_first, InputIt1 x_last, InputIt2 y_first) {
+    constexpr std::size_t lanes = detail::statistics_lanes;
+    if (x_first == x_last) {
+      return;
+    }
+
+    const value_type x_shift =
+        count_ ? x_mean_ : x_mean_type(*x_first).value();
+    const value_type y_shift =
+        count_ ? y_mean_ : y_mean_type(*y_first).value();
+    value_type x_sum[lanes] = {};
+    value_type y_sum[lanes] = {};
+    value_type products[lanes] = {};
+    std::size_t n = 0;
+    while (x_first != x_last) {
+      value_type dx[lanes] = {};
+      value_type dy[lanes] = {};
+      for (std::size_t i = 0; i < lanes && x_first != x_last;
+           ++i, ++x_first, ++y_first, ++n) {
+        dx[i] = x_mean_type(*x_first).value() - x_shift;
+        dy[i] = y_mean_type(*y_first).value() - y_shift;
+      }
+      for (std::size_t i = 0; i < lanes; ++i) {
+        x_sum[i] += dx[i];
+        y_sum[i] += dy[i];
+        products[i] += dx[i] * dy[i];
+      }
+    }
+
+    value_type sx = 0;
+    value_type sy = 0;
+    value_type sxy = 0;
+    for (std::size_t i = 0; i < lanes; ++i) {
+      sx += x_sum[i];
+      sy += y_sum[i];
+      sxy += products[i];
+    }
+    const value_type x_block = sx / static_cast<value_type>(n);
+    const value_type y_block = sy / static_cast<value_type>(n);
+    merge(n, x_shift + x_block, y_shift + y_block, sxy - sx * y_block);
+  }
+
+  void merge(const running_covariance& other) {
+    merge(other.count_, other.x_mean_, other.y_mean_, other.c_);
+  }
+
+  std::size_t count() const { return count_; }
+
+  x_mean_type x_mean() const { return x_mean_type(x_mean_); }
+  y_mean_type y_mean() const { return y_mean_type(y_mean_); }
+
+  // Population covariance of the sample pairs
+  covariance_type covariance() const {
+    return covariance_type(c_ / static_cast<value_type>(count_));
+  }
+
+  // Unbiased covariance estimate with Bessel's correction
+  covariance_type sample_covariance() const {
+    return covariance_type(c_ / static_cast<value_type>(count_ - 1));
+  }
+
+ private:
+  void merge(std::size_t count, value_type x_mean, value_type y_mean,
+             value_type c) {
+    if (count == 0) {
+      return;
+    }
+    const std::size_t total = count_ + count;
+    const value_type weight =
+        static_cast<value_type>(count) / static_cast<value_type>(total);
+    const value_type dx = x_mean - x_mean_;
+    const value_type dy = y_mean - y_mean_;
+    x_mean_ += dx * weight;
+    y_mean_ += dy * weight;
+    c_ += c + dx * dy * static_cast<value_type>(count_) * weight;
+    count_ = total;
+  }
+
+  std::size_t count_;
+  value_type x_mean_;
+  value_type y_mean_;
+  value_type c_;
+};
+
+}  // namespace scalr
+
+#endif
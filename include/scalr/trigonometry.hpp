@@ -0,0 +1,243 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_TRIGONOMETRY_HPP
+#define SCALR_TRIGONOMETRY_HPP
+
+#include <cmath>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include "scalr/bam.hpp"
+#include "scalr/math.hpp"
+#include "scalr/named_quantity/angle.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+namespace detail {
+
+template <typename Unit>
+struct is_angle_unit
+    : std::is_same<typename Unit::dimension, angle_dimension> {};
+
+// Number of turns in one unit of an angle unit
+template <typename Unit, typename T>
+struct turns_per_unit {
+  static constexpr T value() {
+    return static_cast<T>(static_cast<long double>(Unit::ratio::num) /
+                          Unit::ratio::den * pi_power(unit_pi<Unit>::value));
+  }
+};
+
+// Reduces an angle value to a fraction of a turn in [-1/2, 1/2]. Units that
+// divide a turn evenly (turns, degrees, gradians) are reduced by a whole
+// period in their own unit first, which is exact, and scaled afterwards.
+template <typename Unit, typename T,
+          bool Divides = (Unit::ratio::num == 1 &&
+                          unit_pi<Unit>::value == 0)>
+struct turn_reduction {
+  static T apply(T value) {
+    const T turns = value * turns_per_unit<Unit, T>::value();
+    return turns - std::nearbyint(turns);
+  }
+};
+
+template <typename Unit, typename T>
+struct turn_reduction<Unit, T, true> {
+  static T apply(T value) {
+    const T period = static_cast<T>(Unit::ratio::den);
+    const T inverse = turns_per_unit<Unit, T>::value();
+    return (value - period * std::nearbyint(value * inverse)) * inverse;
+  }
+};
+
+// Sine and cosine of a reduced turn fraction. The argument is split into a
+// quadrant and a remainder within [-pi/4, pi/4], where Taylor polynomials of
+// degree 17 (sine) and 16 (cosine) are accurate to double precision. Quadrant
+// selection uses no branches so that batch loops vectorize.
+template <typename T>
+inline std::pair<T, T> sincos_turns(T turns) {
+  const T quarters = 4 * turns;
+  const T nearest = std::nearbyint(quarters);
+  const T x = (quarters - nearest) * static_cast<T>(pi / 2);
+  const T x2 = x * x;
+  constexpr long double sin17 = 1.0L / 355687428096000;
+  constexpr long double cos16 = 1.0L / 20922789888000;
+
+  const T s =
+      x + x * x2 *
+              (T(-1.0L / 6) +
+               x2 * (T(1.0L / 120) +
+                     x2 * (T(-1.0L / 5040) +
+                           x2 * (T(1.0L / 362880) +
+                                 x2 * (T(-1.0L / 39916800) +
+                                       x2 * (T(1.0L / 6227020800) +
+                                             x2 * (T(-1.0L / 1307674368000) +
+                                                   x2 * T(sin17))))))));
+  const T c =
+      1 + x2 * (T(-1.0L / 2) +
+                x2 * (T(1.0L / 24) +
+                      x2 * (T(-1.0L / 720) +
+                            x2 * (T(1.0L / 40320) +
+                                  x2 * (T(-1.0L / 3628800) +
+                                        x2 * (T(1.0L / 479001600) +
+                                              x2 * (T(-1.0L / 87178291200) +
+                                                    x2 * T(cos16))))))));
+
+  // Quadrant selection as exact blends, one term of which is always zero
+  const int quadrant = static_cast<int>(nearest);
+  const T odd = static_cast<T>(quadrant & 1);
+  const T even = 1 - odd;
+  const T sin_sign = static_cast<T>(1 - (quadrant & 2));
+  const T cos_sign = static_cast<T>(1 - ((quadrant + 1) & 2));
+  return std::pair<T, T>(sin_sign * (odd * c + even * s),
+                         cos_sign * (odd * s + even * c));
+}
+
+// Binary angles are exact fractions of a turn in [0, 1) and need no
+// reduction; the quadrant bits of sincos_turns ignore the extra full turn.
+template <typename Rep, typename Unit, typename T,
+          bool = is_binary_angle<Rep, Unit>::value>
+struct angle_turns {
+  static T apply(Rep value) {
+    return turn_reduction<Unit, T>::apply(static_cast<T>(value));
+  }
+};
+
+template <typename Rep, typename Unit, typename T>
+struct angle_turns<Rep, Unit, T, true> {
+  static T apply(Rep value) {
+    return static_cast<T>(value) / static_cast<T>(Unit::ratio::den);
+  }
+};
+
+template <typename Rep, typename Unit>
+std::pair<floating_value_t<Rep>, floating_value_t<Rep>> angle_sincos(
+    const quantity<Rep, Unit>& angle) {
+  using T = floating_value_t<Rep>;
+  return sincos_turns(angle_turns<Rep, Unit, T>::apply(angle.value()));
+}
+
+}  // namespace detail
+
+//******************************
+// Trigonometric Functions
+//******************************
+
+// Sine and cosine of an angle in any unit as a (sin, cos) pair
+template <typename Rep, typename Unit,
+          typename std::enable_if<detail::is_angle_unit<Unit>::value,
+                                  int>::type = 0>
+std::pair<detail::floating_value_t<Rep>, detail::floating_value_t<Rep>> sincos(
+    const quantity<Rep, Unit>& angle) {
+  return detail::angle_sincos(angle);
+}
+
+template <typename Rep, typename Unit,
+          typename std::enable_if<detail::is_angle_unit<Unit>::value,
+                                  int>::type = 0>
+detail::floating_value_t<Rep> sin(const quantity<Rep, Unit>& angle) {
+  return detail::angle_sincos(angle).first;
+}
+
+template <typename Rep, typename Unit,
+          typename std::enable_if<detail::is_angle_unit<Unit>::value,
+                                  int>::type = 0>
+detail::floating_value_t<Rep> cos(const quantity<Rep, Unit>& angle) {
+  return detail::angle_sincos(angle).second;
+}
+
+template <typename Rep, typename Unit,
+          typename std::enable_if<detail::is_angle_unit<Unit>::value,
+                                  int>::type = 0>
+detail::floating_value_t<Rep> tan(const quantity<Rep, Unit>& angle) {
+  const auto result = detail::angle_sincos(angle);
+  return result.first / result.second;
+}
+
+// The angle between the positive x axis and the point (x, y), where x and y
+// are quantities of the same dimension. The result is in turns unless a
+// Target angle quantity is given.
+template <typename Target = void, typename T1, typename U1, typename T2,
+          typename U2>
+typename std::conditional<
+    std::is_void<Target>::value,
+    angle<detail::floating_value_t<typename std::common_type<T1, T2>::type>>,
+    Target>::type
+atan2(const quantity<T1, U1>& y, const quantity<T2, U2>& x) {
+  using result_type = typename std::conditional<
+      std::is_void<Target>::value,
+      angle<detail::floating_value_t<typename std::common_type<T1, T2>::type>>,
+      Target>::type;
+  using T = detail::floating_value_t<typename result_type::value_type>;
+  using cross = detail::quantity_cross<quantity<T1, U1>, quantity<T2, U2>>;
+  static_assert(detail::is_angle_unit<typename result_type::unit>::value,
+                "atan2 target must be an angle quantity");
+
+  constexpr T scale =
+      static_cast<T>(1 / (2 * detail::pi *
+                          detail::turns_per_unit<typename result_type::unit,
+                                                 long double>::value()));
+  return result_type(static_cast<typename result_type::value_type>(
+      std::atan2(static_cast<T>(cross::left(y)),
+                 static_cast<T>(cross::right(x))) *
+      scale));
+}
+
+// Batch trigonometric functions over ranges of angles
+template <class InputIt, class OutputIt>
+OutputIt sin(InputIt first, InputIt last, OutputIt d_first) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = sin(*first);
+  }
+  return d_first;
+}
+
+template <class InputIt, class OutputIt>
+OutputIt cos(InputIt first, InputIt last, OutputIt d_first) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = cos(*first);
+  }
+  return d_first;
+}
+
+template <class InputIt, class OutputIt>
+OutputIt tan(InputIt first, InputIt last, OutputIt d_first) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = tan(*first);
+  }
+  return d_first;
+}
+
+template <class InputIt, class SinIt, class CosIt>
+std::pair<SinIt, CosIt> sincos(InputIt first, InputIt last, SinIt sin_first,
+                               CosIt cos_first) {
+  for (; first != last; ++first, ++sin_first, ++cos_first) {
+    const auto result = sincos(*first);
+    *sin_first = result.first;
+    *cos_first = result.second;
+  }
+  return std::pair<SinIt, CosIt>(sin_first, cos_first);
+}
+
+template <class Target = void, class InputIt1, class InputIt2,
+          class OutputIt>
+OutputIt atan2(InputIt1 y_first, InputIt1 y_last, InputIt2 x_first,
+               OutputIt d_first) {
+  for (; y_first != y_last; ++y_first, ++x_first, ++d_first) {
+    *d_first = atan2<Target>(*y_first, *x_first);
+  }
+  return d_first;
+}
+
+}  // namespace scalr
+
+#endif
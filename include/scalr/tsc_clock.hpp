@@ -0,0 +1,130 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_TSC_CLOCK_HPP
+#define SCALR_TSC_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define SCALR_TSC_AVAILABLE 1
+#endif
+
+#include "scalr/dimension.hpp"
+#include "scalr/named_quantity/time.hpp"
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Whether the time stamp counter runs at a constant rate in all power states
+inline bool has_invariant_tsc() {
+#if defined(SCALR_TSC_AVAILABLE)
+  unsigned eax, ebx, ecx, edx;
+  return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8));
+#else
+  return false;
+#endif
+}
+
+inline std::int64_t steady_ticks() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace detail
+
+/* Cycle counter clock
+ *
+ * Reads the invariant time stamp counter where the processor has one and the
+ * steady clock in nanoseconds elsewhere. Readings are dimensionless tick
+ * counts, so hot paths add and subtract them as integers. The length of a
+ * tick is only known at run time: it is calibrated against the steady clock
+ * once, on the first call to calibrate() or to a conversion, and to_duration
+ * converts tick counts to any duration type when they are reported.
+ */
+class tsc_clock {
+ public:
+  using ticks = quantity<std::int64_t, make_unit_t<dimensionless>>;
+
+  static bool invariant() {
+    static const bool has_tsc = detail::has_invariant_tsc();
+    return has_tsc;
+  }
+
+  static ticks now() {
+#if defined(SCALR_TSC_AVAILABLE)
+    if (invariant()) {
+      return ticks(static_cast<std::int64_t>(__rdtsc()));
+    }
+#endif
+    return ticks(detail::steady_ticks());
+  }
+
+  // Nanoseconds per tick, measured over a busy wait of about 10 ms
+  static double calibrate() {
+    static const double nanoseconds_per_tick = measure();
+    return nanoseconds_per_tick;
+  }
+
+  template <typename Duration = nanoseconds>
+  static Duration to_duration(const ticks& t) {
+    return quantity_cast<Duration>(duration<double, std::nano>(
+        static_cast<double>(t.value()) * calibrate()));
+  }
+
+ private:
+  static double measure() {
+    if (!invariant()) {
+      return 1.0;
+    }
+    const std::int64_t start = detail::steady_ticks();
+    const ticks first = now();
+    std::int64_t elapsed = 0;
+    while (elapsed < 10000000) {
+      elapsed = detail::steady_ticks() - start;
+    }
+    const ticks last = now();
+    return static_cast<double>(elapsed) /
+           static_cast<double>((last - first).value());
+  }
+};
+
+/* Class template scoped timer
+ *
+ * Adds the ticks elapsed between its construction and destruction to a
+ * counter of tsc_clock::ticks, such as a plain quantity, an atomic_quantity
+ * or a sharded_counter.
+ */
+template <typename Counter>
+class scoped_timer {
+ public:
+  explicit scoped_timer(Counter& counter)
+      : counter_(counter), start_(tsc_clock::now()) {}
+
+  scoped_timer(const scoped_timer&) = delete;
+  scoped_timer& operator=(const scoped_timer&) = delete;
+
+  ~scoped_timer() { counter_ += tsc_clock::now() - start_; }
+
+ private:
+  Counter& counter_;
+  tsc_clock::ticks start_;
+};
+
+}  // namespace scalr
+
+#endif
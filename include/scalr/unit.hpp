@@ -17,13 +17,21 @@
 
 namespace scalr {
 
-/* Class template physical unit type */
-template <class DimensionT, class Ratio = std::ratio<1>>
+/* Class template physical unit type
+ *
+ * A unit is Ratio * pi^Pi times the coherent unit of its dimension. Units
+ * without a pi member, such as all named units except radians, have Pi = 0.
+ */
+template <class DimensionT, class Ratio = std::ratio<1>, intmax_t Pi = 0>
 struct unnamed_unit {
   using dimension = DimensionT;
   using ratio = Ratio;
+  static constexpr intmax_t pi = Pi;
 };
 
+template <class DimensionT, class Ratio, intmax_t Pi>
+constexpr intmax_t unnamed_unit<DimensionT, Ratio, Pi>::pi;
+
 namespace detail {
 
 template <intmax_t K>
@@ -61,12 +69,201 @@ struct ratio_lcrm : std::ratio<scalr::detail::lcm<R1::num, R2::num>::value,
 template <bool B>
 using bool_constant = std::integral_constant<bool, B>;
 
+// Wide rational arithmetic
+// Unit ratios are combined as 128-bit rationals (where the compiler provides
+// them) and narrowed to std::ratio only for the resulting unit. Intermediate
+// products and common denominators beyond intmax_t therefore do not overflow.
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 wide_int;
+__extension__ typedef unsigned __int128 wide_uint;
+#else
+typedef intmax_t wide_int;
+typedef uintmax_t wide_uint;
+#endif
+
+constexpr wide_int wide_max() {
+  return static_cast<wide_int>(~static_cast<wide_uint>(0) >> 1);
+}
+
+constexpr wide_int wide_abs(wide_int x) { return x < 0 ? -x : x; }
+
+constexpr wide_int wide_gcd(wide_int m, wide_int n) {
+  return n == 0 ? wide_abs(m) : wide_gcd(n, m % n);
+}
+
+constexpr bool wide_multiply_fits(wide_int m, wide_int n) {
+  return n == 0 || wide_abs(m) <= wide_max() / wide_abs(n);
+}
+
+template <wide_int Num, wide_int Den = 1>
+struct wide_ratio {
+  static_assert(Den != 0, "ratio denominator must be non-zero");
+
+  static constexpr wide_int num = (Den < 0 ? -Num : Num) / wide_gcd(Num, Den);
+  static constexpr wide_int den = wide_abs(Den) / wide_gcd(Num, Den);
+};
+
+template <wide_int Num, wide_int Den>
+constexpr wide_int wide_ratio<Num, Den>::num;
+
+template <wide_int Num, wide_int Den>
+constexpr wide_int wide_ratio<Num, Den>::den;
+
+template <class R1, class R2>
+struct wide_ratio_multiply_parts {
+  static constexpr wide_int n1 = R1::num / wide_gcd(R1::num, R2::den);
+  static constexpr wide_int d2 = R2::den / wide_gcd(R1::num, R2::den);
+  static constexpr wide_int n2 = R2::num / wide_gcd(R2::num, R1::den);
+  static constexpr wide_int d1 = R1::den / wide_gcd(R2::num, R1::den);
+
+  static constexpr bool fits =
+      wide_multiply_fits(n1, n2) && wide_multiply_fits(d1, d2);
+};
+
+template <class R1, class R2>
+struct wide_ratio_multiply {
+  using parts = wide_ratio_multiply_parts<R1, R2>;
+
+  static_assert(parts::fits, "unit ratio arithmetic overflows");
+
+  using type = wide_ratio<parts::n1 * parts::n2, parts::d1 * parts::d2>;
+};
+
+template <class R1, class R2>
+using wide_ratio_multiply_t = typename wide_ratio_multiply<R1, R2>::type;
+
+// Multiplication that reports overflow instead of failing
+template <class R1, class R2,
+          bool = wide_ratio_multiply_parts<R1, R2>::fits>
+struct wide_ratio_try_multiply : std::false_type {};
+
+template <class R1, class R2>
+struct wide_ratio_try_multiply<R1, R2, true> : std::true_type {
+  using type = wide_ratio_multiply_t<R1, R2>;
+};
+
+template <class R1, class R2>
+using wide_ratio_divide_t =
+    wide_ratio_multiply_t<R1, wide_ratio<R2::den, R2::num>>;
+
+template <class... Rn>
+struct wide_ratio_product {
+  using type = wide_ratio<1>;
+};
+
+template <class R1, class... Rn>
+struct wide_ratio_product<R1, Rn...> {
+  using type =
+      wide_ratio_multiply_t<R1, typename wide_ratio_product<Rn...>::type>;
+};
+
+template <class R, intmax_t k, bool = (k < 0)>
+struct wide_ratio_power {
+  using type =
+      wide_ratio_multiply_t<R, typename wide_ratio_power<R, k - 1>::type>;
+};
+
+template <class R>
+struct wide_ratio_power<R, 0, false> {
+  using type = wide_ratio<1>;
+};
+
+template <class R, intmax_t k>
+struct wide_ratio_power<R, k, true> {
+  using type = wide_ratio_divide_t<wide_ratio<1>,
+                                   typename wide_ratio_power<R, -k>::type>;
+};
+
+// gcrd(a/b, c/d) = gcd(a,c)/lcm(b,d) for reduced ratios
+template <class R1, class R2>
+struct wide_ratio_gcrd {
+  static constexpr wide_int d1 = R1::den / wide_gcd(R1::den, R2::den);
+
+  static_assert(wide_multiply_fits(d1, R2::den),
+                "unit ratio arithmetic overflows");
+
+  using type = wide_ratio<wide_gcd(R1::num, R2::num), d1 * R2::den>;
+};
+
+template <class R>
+struct wide_ratio_fits
+    : bool_constant<(R::num <= INTMAX_MAX) && (R::num >= -INTMAX_MAX) &&
+                    (R::den <= INTMAX_MAX)> {};
+
+template <class R>
+struct wide_ratio_narrow {
+  static_assert(wide_ratio_fits<R>::value,
+                "unit ratio is out of the range of std::ratio");
+
+  using type =
+      std::ratio<static_cast<intmax_t>(R::num), static_cast<intmax_t>(R::den)>;
+};
+
+template <class R>
+using wide_ratio_narrow_t = typename wide_ratio_narrow<R>::type;
+
+// Whether x^k <= n for non-negative x and n
+constexpr bool wide_power_at_most(wide_int x, intmax_t k, wide_int n,
+                                  wide_int acc = 1) {
+  return k == 0                      ? acc <= n
+         : (x != 0 && acc > n / x)   ? false
+                                     : wide_power_at_most(x, k - 1, n, acc * x);
+}
+
+// Integer k-th root by bisection with lo^k <= n < hi^k
+constexpr wide_int wide_root_search(wide_int n, intmax_t k, wide_int lo,
+                                    wide_int hi) {
+  return hi - lo <= 1 ? lo
+         : wide_power_at_most(lo + (hi - lo) / 2, k, n)
+             ? wide_root_search(n, k, lo + (hi - lo) / 2, hi)
+             : wide_root_search(n, k, lo, lo + (hi - lo) / 2);
+}
+
+constexpr wide_int wide_root(wide_int n, intmax_t k) {
+  return wide_root_search(n, k, 0, n + 1);
+}
+
+// The k-th root of a positive ratio, exact if both terms are k-th powers
+template <class R, intmax_t k>
+struct wide_ratio_root {
+  static constexpr wide_int num = wide_root(R::num, k);
+  static constexpr wide_int den = wide_root(R::den, k);
+
+  static constexpr bool exact = !wide_power_at_most(num, k, R::num - 1) &&
+                                !wide_power_at_most(den, k, R::den - 1);
+
+  using type = wide_ratio<num, den>;
+};
+
 template <typename T>
 struct is_ratio : std::false_type {};
 
 template <intmax_t Num, intmax_t Den>
 struct is_ratio<std::ratio<Num, Den>> : std::true_type {};
 
+// Power of pi in the scale of a unit
+template <class U, class = void>
+struct unit_pi : std::integral_constant<intmax_t, 0> {};
+
+template <class U>
+struct unit_pi<U, decltype(void(U::pi))>
+    : std::integral_constant<intmax_t, U::pi> {};
+
+template <class... Un>
+struct unit_pi_sum : std::integral_constant<intmax_t, 0> {};
+
+template <class U1, class... Un>
+struct unit_pi_sum<U1, Un...>
+    : std::integral_constant<intmax_t,
+                             unit_pi<U1>::value + unit_pi_sum<Un...>::value> {};
+
+constexpr long double pi = 3.141592653589793238462643383279502884L;
+
+// pi^k in extended precision; the result is rounded once to the target type
+constexpr long double pi_power(intmax_t k) {
+  return k == 0 ? 1.0L : k > 0 ? pi * pi_power(k - 1) : pi_power(k + 1) / pi;
+}
+
 template <class U>
 struct is_unit_type {
   static constexpr bool value = std::integral_constant < bool,
@@ -76,6 +273,10 @@ struct is_unit_type {
 
 }  // namespace detail
 
+// Compile-time list of unit types
+template <class... Units>
+struct unit_list {};
+
 namespace unit {
 
 template <class U1, class U2>
@@ -86,20 +287,48 @@ struct equal {
   using R2 = typename U2::ratio;
   static constexpr bool value = std::integral_constant < bool,
                         scalr::dimension_equal<D1, D2>::value
-                                &&std::ratio_equal<R1, R2>::value > ::value;
+                                &&std::ratio_equal<R1, R2>::value &&
+                        (scalr::detail::unit_pi<U1>::value ==
+                         scalr::detail::unit_pi<U2>::value) > ::value;
 };
 
 // Compile-time unit_type arithmetic
-template <class D, class Ratio>
+template <class D, class Ratio, intmax_t Pi = 0>
 struct make {
-  using type = unnamed_unit<D, Ratio>;
+  using type = unnamed_unit<D, Ratio, Pi>;
+};
+
+// Named units of a dimension, listed by the header that names them
+template <class D>
+struct named {
+  using type = unit_list<>;
 };
 
 template <class U1, class...>
 struct sum {
   using D1 = typename U1::dimension;
   using R1 = typename U1::ratio;
-  using type = typename make<D1, R1>::type;
+  using type =
+      typename make<D1, R1, scalr::detail::unit_pi<U1>::value>::type;
+};
+
+// The greatest common rational divisor of the two ratios is the unit in which
+// both operands are exact multiples. Units differing by a power of pi have no
+// such common unit; their sum is in the unit of the first operand.
+template <class U1, class U2,
+          bool = (scalr::detail::unit_pi<U1>::value ==
+                  scalr::detail::unit_pi<U2>::value)>
+struct rational_sum {
+  using type = typename sum<U1>::type;
+};
+
+template <class U1, class U2>
+struct rational_sum<U1, U2, true> {
+  using R = typename scalr::detail::wide_ratio_gcrd<typename U1::ratio,
+                                                    typename U2::ratio>::type;
+  using type = typename make<typename U1::dimension,
+                             scalr::detail::wide_ratio_narrow_t<R>,
+                             scalr::detail::unit_pi<U1>::value>::type;
 };
 
 template <class U1, class U2>
@@ -111,15 +340,11 @@ struct sum<U1, U2> {
 
   using D1 = typename U1::dimension;
   using D2 = typename U2::dimension;
-  using R1 = typename U1::ratio;
-  using R2 = typename U2::ratio;
 
   static_assert(std::is_same<D1, D2>::value,
                 "unit dimensions must match for addition/subtraction");
 
-  using type = typename make<
-      D1, std::ratio<scalr::detail::gcd<R1::num, R2::num>::value,
-                     scalr::detail::lcm<R1::den, R2::den>::value>>::type;
+  using type = typename rational_sum<U1, U2>::type;
 };
 
 template <class U1, class U2, class... Un>
@@ -129,63 +354,59 @@ struct sum<U1, U2, Un...> {
   using type = typename sum<U1, typename sum<U2, Un...>::type>::type;
 };
 
-template <class...>
+// Ratios of all factors are multiplied in wide arithmetic before narrowing,
+// so only the overall product must fit in std::ratio. Powers of pi add up.
+template <class... Un>
 struct product {
-  using type = typename make<dimensionless, std::ratio<1>>::type;
-};
-
-template <class U1, class U2>
-struct product<U1, U2> {
-  using type = typename make<
-      dimension_product_t<typename U1::dimension, typename U2::dimension>,
-      std::ratio_multiply<typename U1::ratio, typename U2::ratio>>::type;
-};
-
-template <class U1, class... Un>
-struct product<U1, Un...> {
-  using type = typename product<U1, typename product<Un...>::type>::type;
+  using R = typename scalr::detail::wide_ratio_product<
+      typename Un::ratio...>::type;
+  using type =
+      typename make<dimension_product_t<typename Un::dimension...>,
+                    scalr::detail::wide_ratio_narrow_t<R>,
+                    scalr::detail::unit_pi_sum<Un...>::value>::type;
 };
 
 template <class U>
 struct inverse {
   using type =
       typename make<dimension_inverse_t<typename U::dimension>,
-                    std::ratio_divide<std::ratio<1>, typename U::ratio>>::type;
-};
-
-template <class U, uintmax_t k>
-struct uexponent {
-  using type = typename product<typename uexponent<U, k - 1>::type, U>::type;
-};
-
-template <class U>
-struct uexponent<U, 0> {
-  using type = typename make<dimensionless, std::ratio<1>>::type;
+                    std::ratio_divide<std::ratio<1>, typename U::ratio>,
+                    -scalr::detail::unit_pi<U>::value>::type;
 };
 
-template <class U, intmax_t k, bool>
-struct exponent_impl {};
-
 template <class U, intmax_t k>
-struct exponent_impl<U, k, true> {
-  using type = typename inverse<typename uexponent<U, -k>::type>::type;
+struct exponent {
+  using R =
+      typename scalr::detail::wide_ratio_power<typename U::ratio, k>::type;
+  using type =
+      typename make<dimension_exponent_t<typename U::dimension, k>,
+                    scalr::detail::wide_ratio_narrow_t<R>,
+                    scalr::detail::unit_pi<U>::value * k>::type;
 };
 
+// The k-th root of a unit. Units whose ratio or power of pi has no exact root
+// yield the coherent unit of the root dimension instead, to which quantities
+// are converted before taking the root.
 template <class U, intmax_t k>
-struct exponent_impl<U, k, false> {
-  using type = typename uexponent<U, k>::type;
-};
+struct root {
+  using R = scalr::detail::wide_ratio_root<typename U::ratio, k>;
 
-template <class U, intmax_t k>
-struct exponent {
-  using type = typename exponent_impl<U, k, (k < 0)>::type;
+  static constexpr bool exact =
+      R::exact && scalr::detail::unit_pi<U>::value % k == 0;
+
+  using type = typename make<
+      dimension_root_t<typename U::dimension, k>,
+      typename std::conditional<
+          exact, scalr::detail::wide_ratio_narrow_t<typename R::type>,
+          std::ratio<1>>::type,
+      exact ? scalr::detail::unit_pi<U>::value / k : 0>::type;
 };
 
 }  // namespace unit
 
 // Helper traits
-template <class Dimension, class Ratio = std::ratio<1>>
-using make_unit_t = typename unit::make<Dimension, Ratio>::type;
+template <class Dimension, class Ratio = std::ratio<1>, intmax_t Pi = 0>
+using make_unit_t = typename unit::make<Dimension, Ratio, Pi>::type;
 
 template <class... D>
 using unit_sum_t = typename unit::sum<D...>::type;
@@ -199,9 +420,15 @@ using unit_inverse_t = typename unit::inverse<U>::type;
 template <class U, intmax_t k>
 using unit_exponent_t = typename unit::exponent<U, k>::type;
 
+template <class U, intmax_t k>
+using unit_root_t = typename unit::root<U, k>::type;
+
 template <class U1, class U2>
 using unit_equal = typename unit::equal<U1, U2>;
 
+template <class D>
+using named_units_t = typename unit::named<D>::type;
+
 }  // namespace scalr
 
 #endif
@@ -0,0 +1,134 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_UNIT_TABLE_HPP
+#define SCALR_UNIT_TABLE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "scalr/quantity.hpp"
+#include "scalr/unit.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Coherent units in one unit U, in extended precision
+template <class U>
+constexpr long double coherent_factor() {
+  return static_cast<long double>(U::ratio::num) / U::ratio::den *
+         pi_power(unit_pi<U>::value);
+}
+
+// Position of the first unit in a list equal to U, or the length of the list
+template <class U, class List>
+struct unit_list_index : std::integral_constant<std::size_t, 0> {};
+
+template <class U, class U1, class... Un>
+struct unit_list_index<U, unit_list<U1, Un...>>
+    : std::integral_constant<
+          std::size_t,
+          unit::equal<U, U1>::value
+              ? 0
+              : 1 + unit_list_index<U, unit_list<Un...>>::value> {};
+
+template <class List>
+struct unit_list_size;
+
+template <class... Units>
+struct unit_list_size<unit_list<Units...>>
+    : std::integral_constant<std::size_t, sizeof...(Units)> {};
+
+}  // namespace detail
+
+// Run-time identifier of a named unit: its position in the named units of
+// its dimension
+template <class Unit>
+struct unit_id
+    : detail::unit_list_index<Unit, named_units_t<typename Unit::dimension>> {
+  static_assert(
+      detail::unit_list_index<Unit,
+                              named_units_t<typename Unit::dimension>>::value <
+          detail::unit_list_size<
+              named_units_t<typename Unit::dimension>>::value,
+      "unit is not a named unit of its dimension");
+};
+
+/* Class template conversion table of the named units of a dimension
+ *
+ * Units are selected at run time by their unit_id. The table holds the size
+ * of every named unit in coherent units, computed at compile time, so a
+ * conversion between two units is one division of table entries, after which
+ * each value takes a single multiply.
+ */
+template <class Dimension, class List = named_units_t<Dimension>>
+struct unit_table;
+
+template <class Dimension, class... Units>
+struct unit_table<Dimension, unit_list<Units...>> {
+  static_assert(sizeof...(Units) > 0, "dimension has no named units");
+
+  static constexpr std::size_t size = sizeof...(Units);
+  static constexpr long double factors[sizeof...(Units)] = {
+      detail::coherent_factor<Units>()...};
+
+  // Factor from unit id `from` to unit id `to`
+  template <typename T = double>
+  static T factor(std::size_t from, std::size_t to) {
+    return static_cast<T>(factors[from] / factors[to]);
+  }
+
+  // Factor from a unit known at compile time to unit id `to`
+  template <class Unit, typename T = double>
+  static T factor_from(std::size_t to) {
+    static_assert(std::is_same<typename Unit::dimension, Dimension>::value,
+                  "unit must have the dimension of the table");
+    return static_cast<T>(detail::coherent_factor<Unit>() / factors[to]);
+  }
+};
+
+template <class Dimension, class... Units>
+constexpr std::size_t unit_table<Dimension, unit_list<Units...>>::size;
+
+template <class Dimension, class... Units>
+constexpr long double
+    unit_table<Dimension, unit_list<Units...>>::factors[sizeof...(Units)];
+
+// Converts values from one named unit of a dimension to another, both
+// selected at run time
+template <class Dimension, class InputIt, class OutputIt>
+OutputIt convert(InputIt first, InputIt last, OutputIt d_first,
+                 std::size_t from, std::size_t to) {
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  static_assert(std::is_floating_point<T>::value,
+                "run-time unit conversion requires floating-point values");
+  const T f = unit_table<Dimension>::template factor<T>(from, to);
+  for (; first != last; ++first, ++d_first) {
+    *d_first = *first * f;
+  }
+  return d_first;
+}
+
+// The value of a quantity in a named unit of its dimension selected at run
+// time
+template <typename Rep, typename Unit>
+typename std::conditional<std::is_floating_point<Rep>::value, Rep,
+                          double>::type
+convert(const quantity<Rep, Unit>& q, std::size_t to) {
+  using T = typename std::conditional<std::is_floating_point<Rep>::value, Rep,
+                                      double>::type;
+  return static_cast<T>(q.value()) *
+         unit_table<typename Unit::dimension>::template factor_from<Unit, T>(
+             to);
+}
+
+}  // namespace scalr
+
+#endif
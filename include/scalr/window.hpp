@@ -0,0 +1,282 @@
+/*
+ * Scalr: Physical quantity/unit representation & manipulation library
+ *
+ * Copyright (c) 2020-2023 Dogan Ulus
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef SCALR_WINDOW_HPP
+#define SCALR_WINDOW_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "scalr/math.hpp"
+#include "scalr/named_quantity/time.hpp"
+#include "scalr/quantity.hpp"
+
+namespace scalr {
+namespace detail {
+
+// Remainder of a floored division by a positive divisor, which is never
+// negative unlike the remainder of integer division
+template <typename Rep>
+constexpr Rep floored_remainder(Rep value, Rep divisor) {
+  return value % divisor < 0 ? value % divisor + divisor : value % divisor;
+}
+
+// Start of the window of the given size that contains a timestamp, also
+// for timestamps before the epoch
+template <typename Timestamp>
+constexpr Timestamp window_floor(const Timestamp& time,
+                                 const Timestamp& size) {
+  return Timestamp(time.value() -
+                   floored_remainder(time.value(), size.value()));
+}
+
+// Window size rounded down to a whole number of hops
+template <typename Timestamp>
+Timestamp whole_hops(const Timestamp& size, const Timestamp& hop) {
+  assert(hop.value() > 0 && "window hop must be positive");
+  assert(!(size < hop) && "window size must be at least one hop");
+  return Timestamp(hop.value() * (size.value() / hop.value()));
+}
+
+}  // namespace detail
+
+/* Class template aggregate of the quantities in a window
+ *
+ * Keeps the count, sum, minimum, maximum and last value of the samples pushed
+ * so far. Aggregates of consecutive parts of a stream merge into the
+ * aggregate of their concatenation.
+ */
+template <typename Q>
+class window_aggregate {
+ public:
+  using quantity_type = Q;
+  using mean_type =
+      quantity<detail::floating_value_t<typename Q::value_type>,
+               typename Q::unit>;
+
+  constexpr window_aggregate()
+      : count_(0), sum_(0), min_(0), max_(0), last_(0) {}
+
+  template <typename Rep, typename Unit>
+  void push(const quantity<Rep, Unit>& sample) {
+    const Q q(sample);
+    min_ = (count_ == 0 || q < min_) ? q : min_;
+    max_ = (count_ == 0 || max_ < q) ? q : max_;
+    sum_ += q;
+    last_ = q;
+    ++count_;
+  }
+
+  // Appends the aggregate of the samples that follow this one
+  void merge(const window_aggregate& next) {
+    if (next.count_ == 0) {
+      return;
+    }
+    min_ = (count_ == 0 || next.min_ < min_) ? next.min_ : min_;
+    max_ = (count_ == 0 || max_ < next.max_) ? next.max_ : max_;
+    sum_ += next.sum_;
+    last_ = next.last_;
+    count_ += next.count_;
+  }
+
+  std::size_t count() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  Q sum() const { return sum_; }
+  Q min() const { return min_; }
+  Q max() const { return max_; }
+  Q last() const { return last_; }
+
+  mean_type mean() const {
+    return mean_type(
+        static_cast<typename mean_type::value_type>(sum_.value()) /
+        static_cast<typename mean_type::value_type>(count_));
+  }
+
+ private:
+  std::size_t count_;
+  Q sum_;
+  Q min_;
+  Q max_;
+  Q last_;
+};
+
+/* Streaming window engines over timestamped quantities
+ *
+ * Timestamps are durations since a common epoch in the unit of Timestamp and
+ * must not decrease. Window and hop sizes may be given in any duration unit
+ * and are converted to Timestamp once. Each sample is aggregated exactly
+ * once. A closed window is reported as emit(start, aggregate), and flush()
+ * reports the window still open. Engines share no state, so independent
+ * series may be aggregated on separate threads.
+ */
+
+// Consecutive windows of a fixed size aligned to multiples of the size. The
+// window of a sample is found by comparing against the end of the current
+// window; only the first sample and gaps longer than a window take a division.
+template <typename Q, typename Timestamp = nanoseconds>
+class tumbling_window {
+  static_assert(std::is_integral<typename Timestamp::value_type>::value,
+                "window timestamps require an integral tick count");
+
+ public:
+  using aggregate_type = window_aggregate<Q>;
+
+  template <typename Rep, typename Unit>
+  explicit tumbling_window(const quantity<Rep, Unit>& size)
+      : size_(quantity_cast<Timestamp>(size)), start_(0) {
+    assert(size_.value() > 0 && "window size must be positive");
+  }
+
+  template <typename Rep, typename Unit, typename Emit>
+  void push(const Timestamp& time, const quantity<Rep, Unit>& sample,
+            Emit emit) {
+    if (aggregate_.empty()) {
+      start_ = detail::window_floor(time, size_);
+    } else if (!(time < start_ + size_)) {
+      emit(start_, aggregate_);
+      aggregate_ = aggregate_type();
+      const Timestamp next = start_ + size_;
+      start_ = time < next + size_ ? next : detail::window_floor(time, size_);
+    }
+    aggregate_.push(sample);
+  }
+
+  template <typename Emit>
+  void flush(Emit emit) {
+    if (!aggregate_.empty()) {
+      emit(start_, aggregate_);
+      aggregate_ = aggregate_type();
+    }
+  }
+
+ private:
+  Timestamp size_;
+  Timestamp start_;
+  aggregate_type aggregate_;
+};
+
+// Windows of a fixed size that start at every multiple of the hop. Samples
+// are aggregated into panes one hop long, and a window merges the panes it
+// covers when it closes, so the window size is taken as a whole number of
+// hops and must be at least one hop. Windows without samples are not
+// reported.
+template <typename Q, typename Timestamp = nanoseconds>
+class sliding_window {
+  static_assert(std::is_integral<typename Timestamp::value_type>::value,
+                "window timestamps require an integral tick count");
+
+ public:
+  using aggregate_type = window_aggregate<Q>;
+
+  template <typename Rep1, typename Unit1, typename Rep2, typename Unit2>
+  sliding_window(const quantity<Rep1, Unit1>& size,
+                 const quantity<Rep2, Unit2>& hop)
+      : hop_(quantity_cast<Timestamp>(hop)),
+        size_(detail::whole_hops(quantity_cast<Timestamp>(size), hop_)),
+        panes_(static_cast<std::size_t>(size_.value() / hop_.value())),
+        newest_(0),
+        started_(false),
+        pane_start_(0) {}
+
+  template <typename Rep, typename Unit, typename Emit>
+  void push(const Timestamp& time, const quantity<Rep, Unit>& sample,
+            Emit emit) {
+    if (!started_) {
+      pane_start_ = detail::window_floor(time, hop_);
+      started_ = true;
+    }
+    while (!(time < pane_start_ + hop_)) {
+      if (advance(emit) == 0) {
+        // No samples left in any pane: skip the gap
+        pane_start_ = detail::window_floor(time, hop_);
+      }
+    }
+    panes_[newest_].push(sample);
+  }
+
+  template <typename Emit>
+  void flush(Emit emit) {
+    while (started_ && advance(emit) != 0) {
+    }
+    started_ = false;
+  }
+
+ private:
+  // Reports the window ending with the newest pane, then opens the next pane
+  // in place of the oldest. Returns the number of samples still in panes.
+  template <typename Emit>
+  std::size_t advance(Emit& emit) {
+    const std::size_t n = panes_.size();
+    aggregate_type window;
+    for (std::size_t k = 1; k <= n; ++k) {
+      window.merge(panes_[(newest_ + k) % n]);
+    }
+    pane_start_ = pane_start_ + hop_;
+    if (!window.empty()) {
+      emit(pane_start_ - size_, window);
+    }
+    newest_ = (newest_ + 1) % n;
+    const std::size_t remaining = window.count() - panes_[newest_].count();
+    panes_[newest_] = aggregate_type();
+    return remaining;
+  }
+
+  Timestamp hop_;
+  Timestamp size_;
+  std::vector<aggregate_type> panes_;
+  std::size_t newest_;
+  bool started_;
+  Timestamp pane_start_;
+};
+
+// Windows of activity separated by gaps longer than a timeout. A session
+// starts at its first sample.
+template <typename Q, typename Timestamp = nanoseconds>
+class session_window {
+ public:
+  using aggregate_type = window_aggregate<Q>;
+
+  template <typename Rep, typename Unit>
+  explicit session_window(const quantity<Rep, Unit>& gap)
+      : gap_(quantity_cast<Timestamp>(gap)), start_(0), last_(0) {}
+
+  template <typename Rep, typename Unit, typename Emit>
+  void push(const Timestamp& time, const quantity<Rep, Unit>& sample,
+            Emit emit) {
+    if (!aggregate_.empty() && gap_ < time - last_) {
+      emit(start_, aggregate_);
+      aggregate_ = aggregate_type();
+    }
+    if (aggregate_.empty()) {
+      start_ = time;
+    }
+    last_ = time;
+    aggregate_.push(sample);
+  }
+
+  template <typename Emit>
+  void flush(Emit emit) {
+    if (!aggregate_.empty()) {
+      emit(start_, aggregate_);
+      aggregate_ = aggregate_type();
+    }
+  }
+
+ private:
+  Timestamp gap_;
+  Timestamp start_;
+  Timestamp last_;
+  aggregate_type aggregate_;
+};
+
+}  // namespace scalr
+
+#endif
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Atomic Quantities") {
+  SECTION("Operations") {
+    scalr::atomic_quantity<double, scalr::unit::meters> d(scalr::meters(1));
+
+    CHECK(d.load().value() == 1.0);
+    CHECK(d.fetch_add(scalr::meters(2)).value() == 1.0);
+    CHECK((d += scalr::meters(1)).value() == 4.0);
+    CHECK(d.fetch_sub(scalr::meters(1)).value() == 4.0);
+
+    // Quantities in other units are converted first
+    d.store(scalr::centimeters(250));
+    CHECK(d.load().value() == 2.5);
+    CHECK(d.exchange(scalr::meters(7)).value() == 2.5);
+
+    scalr::meters expected(1);
+    CHECK_FALSE(d.compare_exchange_strong(expected, scalr::meters(3)));
+    CHECK(expected.value() == 7.0);
+    CHECK(d.compare_exchange_strong(expected, scalr::meters(3)));
+    CHECK(static_cast<scalr::meters>(d).value() == 3.0);
+
+    scalr::atomic_quantity<intmax_t, scalr::unit::nanoseconds> t;
+    t += scalr::nanoseconds(5);
+    t -= scalr::nanoseconds(2);
+    CHECK(t.load().value() == 3);
+    CHECK(t.is_lock_free());
+  }
+
+  SECTION("Concurrent updates") {
+    constexpr int threads = 4;
+    constexpr int updates = 10000;
+
+    scalr::atomic_quantity<double, scalr::unit::joules> energy;
+    scalr::sharded_counter<intmax_t, scalr::unit::nanoseconds, 8> busy;
+    STATIC_CHECK(sizeof(busy) == 8 * scalr::detail::cache_line_size);
+    STATIC_CHECK(alignof(decltype(busy)) <= alignof(std::max_align_t));
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+      workers.emplace_back([&] {
+        for (int k = 0; k < updates; ++k) {
+          energy.fetch_add(scalr::joules(0.5));
+          busy.add(scalr::nanoseconds(3));
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    CHECK(energy.load().value() == 0.5 * threads * updates);
+    CHECK(busy.load().value() == 3 * threads * updates);
+
+    busy.add(scalr::microseconds(1), 5);
+    CHECK(busy.load().value() == 3 * threads * updates + 1000);
+    busy.reset();
+    CHECK(busy.load().value() == 0);
+  }
+}
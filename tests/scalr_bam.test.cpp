@@ -0,0 +1,77 @@
+#include <cfenv>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Binary Angles") {
+  SECTION("Conversions") {
+    STATIC_CHECK(std::is_same<scalr::bam16::ratio,
+                              std::ratio<1, 65536>>::value);
+    STATIC_CHECK(scalr::degrees(scalr::bam16(16384)).value() == 90.0);
+    STATIC_CHECK(scalr::degrees(scalr::bam32(0x80000000u)).value() == 180.0);
+    STATIC_CHECK(scalr::reduced_radians(scalr::bam8(192)).value() == 0.75);
+    STATIC_CHECK(scalr::bam16(scalr::bam8(64)).value() == 16384);
+    CHECK(scalr::radians(scalr::bam16(32768)).value() ==
+          Catch::Approx(3.141592653589793));
+
+    CHECK(scalr::bam_cast<scalr::bam16>(scalr::degrees(90)).value() == 16384);
+    CHECK(scalr::bam_cast<scalr::bam16>(scalr::degrees(-90)).value() == 49152);
+    CHECK(scalr::bam_cast<scalr::bam16>(scalr::degrees(3600 + 45)).value() ==
+          8192);
+    CHECK(scalr::bam_cast<scalr::bam16>(scalr::degrees(1e12)).value() ==
+          scalr::bam_cast<scalr::bam16>(scalr::degrees(280)).value());
+    CHECK(scalr::bam_cast<scalr::bam16>(scalr::radians(3.141592653589793))
+              .value() == 32768);
+    CHECK(scalr::bam_cast<scalr::bam8>(scalr::angle<int, std::ratio<1, 360>>(
+                                           -450))
+              .value() == 192);
+
+    // Half steps round to even in any floating-point rounding mode
+    for (int mode : {FE_TONEAREST, FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO}) {
+      std::fesetround(mode);
+      CHECK(scalr::bam_cast<scalr::bam8>(scalr::degrees(0.703125)).value() ==
+            0);
+      CHECK(scalr::bam_cast<scalr::bam8>(scalr::degrees(2.109375)).value() ==
+            2);
+      CHECK(scalr::bam_cast<scalr::bam8>(scalr::degrees(-0.703125))
+                .value() == 0);
+    }
+    std::fesetround(FE_TONEAREST);
+  }
+
+  SECTION("Wraparound") {
+    CHECK((scalr::bam16(60000) + scalr::bam16(10000)).value() == 4464);
+    CHECK((scalr::bam16(1000) - scalr::bam16(2000)).value() == 64536);
+
+    scalr::bam8 heading(250);
+    heading += scalr::bam8(10);
+    CHECK(heading.value() == 4);
+
+    CHECK(scalr::shortest_difference(scalr::bam16(1000), scalr::bam16(64536))
+              .value() == 2000);
+    CHECK(scalr::shortest_difference(scalr::bam16(64536), scalr::bam16(1000))
+              .value() == -2000);
+    CHECK(scalr::shortest_difference(scalr::bam16(32768), scalr::bam16(0))
+              .value() == -32768);
+    CHECK(scalr::degrees(scalr::shortest_difference(scalr::bam32(0),
+                                                    scalr::bam32(0x40000000u)))
+              .value() == -90.0);
+  }
+
+  SECTION("Trigonometry") {
+    CHECK(scalr::sin(scalr::bam16(16384)) == 1.0);
+    CHECK(scalr::cos(scalr::bam16(32768)) == -1.0);
+    CHECK(scalr::sin(scalr::bam16(49152)) == -1.0);
+    CHECK(scalr::sin(scalr::bam32(0x15555555u)) == Catch::Approx(0.5));
+
+    for (unsigned i = 0; i < 65536; i += 1021) {
+      CHECK(scalr::sin(scalr::bam16(i)) ==
+            Catch::Approx(scalr::sin(scalr::degrees(scalr::bam16(i))))
+                .margin(1e-15));
+    }
+  }
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Bounded Quantities") {
+  using scalr::degrees;
+  using scalr::meters;
+
+  SECTION("Policies") {
+    using clamped = scalr::bounded_quantity<meters, std::ratio<0>,
+                                            std::ratio<10>,
+                                            scalr::clamp_bounds>;
+    CHECK(clamped(meters(-2)).value() == 0);
+    CHECK(clamped(meters(4.5)).value() == 4.5);
+    CHECK(clamped(meters(12)).value() == 10);
+    CHECK(clamped(scalr::centimeters(250)).value() == Catch::Approx(2.5));
+
+    using heading = scalr::bounded_quantity<degrees, std::ratio<0>,
+                                            std::ratio<360>,
+                                            scalr::wrap_bounds>;
+    CHECK(heading(degrees(370)).value() == Catch::Approx(10));
+    CHECK(heading(degrees(-30)).value() == Catch::Approx(330));
+    CHECK(heading(degrees(360)).value() == Catch::Approx(0));
+    // The remainder rounds to the period but the result stays below it
+    CHECK(heading(degrees(-1e-20)).value() == 0);
+
+    using checked = scalr::bounded_quantity<meters, std::ratio<0>,
+                                            std::ratio<10>,
+                                            scalr::throw_bounds>;
+    CHECK(checked(meters(10)).value() == 10);
+    CHECK_THROWS_AS(checked(meters(10.5)), std::out_of_range);
+    CHECK_THROWS_AS(checked(meters(-0.5)), std::out_of_range);
+
+    using steps =
+        scalr::bounded_quantity<scalr::quantity<int, scalr::unit::meters>,
+                                std::ratio<-5>, std::ratio<5>,
+                                scalr::wrap_bounds>;
+    CHECK(steps(scalr::quantity<int, scalr::unit::meters>(7)).value() == -3);
+
+    // Integral wrapping neither wraps around unsigned values nor overflows
+    using unsigned_degrees = scalr::quantity<unsigned, scalr::unit::degrees>;
+    using unsigned_heading =
+        scalr::bounded_quantity<unsigned_degrees, std::ratio<10>,
+                                std::ratio<370>, scalr::wrap_bounds>;
+    CHECK(unsigned_heading(unsigned_degrees(5)).value() == 365);
+    CHECK(unsigned_heading(unsigned_degrees(10)).value() == 10);
+    CHECK(unsigned_heading(unsigned_degrees(370)).value() == 10);
+    CHECK(unsigned_heading(unsigned_degrees(4294967295u)).value() == 255);
+
+    using wrap = scalr::wrap_bounds;
+    CHECK(wrap::apply<std::int8_t>(127, -100, 100) == -73);
+    CHECK(wrap::apply<std::int8_t>(-128, -100, 100) == 72);
+    CHECK(wrap::apply<std::uint8_t>(255, 0, 200) == 55);
+    CHECK(wrap::apply<std::int32_t>(std::numeric_limits<std::int32_t>::max(),
+                                    -2000000000, 2000000000) == -1852516353);
+    CHECK(wrap::apply<std::int32_t>(std::numeric_limits<std::int32_t>::min(),
+                                    -2000000000, 2000000000) == 1852516352);
+    CHECK(wrap::apply<std::int64_t>(std::numeric_limits<std::int64_t>::min(),
+                                    std::numeric_limits<std::int64_t>::min(),
+                                    std::numeric_limits<std::int64_t>::max()) ==
+          std::numeric_limits<std::int64_t>::min());
+    CHECK(wrap::apply<std::int64_t>(std::numeric_limits<std::int64_t>::max(),
+                                    std::numeric_limits<std::int64_t>::min(),
+                                    std::numeric_limits<std::int64_t>::max()) ==
+          std::numeric_limits<std::int64_t>::min());
+  }
+
+  SECTION("Static Bounds") {
+    using percent = scalr::bounded_quantity<meters, std::ratio<0>,
+                                            std::ratio<100>>;
+    using offset = scalr::bounded_quantity<meters, std::ratio<-1, 2>,
+                                           std::ratio<1, 2>>;
+    const percent a(meters(60));
+    const offset b(meters(0.25));
+
+    const auto sum = a + b;
+    STATIC_CHECK(std::is_same<decltype(sum)::lower, std::ratio<-1, 2>>::value);
+    STATIC_CHECK(std::is_same<decltype(sum)::upper, std::ratio<201, 2>>::value);
+    CHECK(sum.value() == Catch::Approx(60.25));
+
+    const auto difference = a - a;
+    STATIC_CHECK(
+        std::is_same<decltype(difference)::lower, std::ratio<-100>>::value);
+    STATIC_CHECK(
+        std::is_same<decltype(difference)::upper, std::ratio<100>>::value);
+    CHECK(difference.value() == 0);
+
+    const auto negated = -b;
+    STATIC_CHECK(
+        std::is_same<decltype(negated)::lower, std::ratio<-1, 2>>::value);
+    CHECK(negated.value() == Catch::Approx(-0.25));
+
+    // Wrapped sums keep their bounds and are wrapped again
+    using heading = scalr::bounded_quantity<degrees, std::ratio<0>,
+                                            std::ratio<360>,
+                                            scalr::wrap_bounds>;
+    const auto turn = heading(degrees(350)) + heading(degrees(20));
+    STATIC_CHECK(std::is_same<decltype(turn), const heading>::value);
+    CHECK(turn.value() == Catch::Approx(10));
+
+    // Wrapped negations keep their bounds and stay half-open
+    using angle = scalr::bounded_quantity<degrees, std::ratio<-180>,
+                                          std::ratio<180>, scalr::wrap_bounds>;
+    const auto opposite = -angle(degrees(-180));
+    STATIC_CHECK(std::is_same<decltype(opposite), const angle>::value);
+    CHECK(opposite.value() == Catch::Approx(-180));
+    CHECK((-heading(degrees(90))).value() == Catch::Approx(270));
+
+    const meters plain = sum;
+    CHECK(plain.value() == Catch::Approx(60.25));
+    CHECK(b < sum);
+  }
+
+  SECTION("Bulk Validation") {
+    using unit_range = scalr::bounded_quantity<meters, std::ratio<-1>,
+                                               std::ratio<1>>;
+    std::vector<meters> samples;
+    for (int i = 0; i < 103; ++i) {
+      samples.push_back(meters((i % 21 - 10) / 10.0));
+    }
+    CHECK(scalr::within_bounds<unit_range>(samples.begin(), samples.end()));
+    CHECK(scalr::within_bounds<unit_range>(samples.end(), samples.end()));
+
+    samples[101] = meters(1.5);
+    CHECK_FALSE(scalr::within_bounds<unit_range>(samples.begin(),
+                                                 samples.end()));
+    samples[101] = meters(0);
+    samples[2] = meters(-1.01);
+    CHECK_FALSE(scalr::within_bounds<unit_range>(samples.begin(),
+                                                 samples.end()));
+
+    // NaN values are out of bounds wherever they are
+    samples[2] = meters(0);
+    const std::vector<meters> nan_inside{meters(1), meters(std::nan("")),
+                                         meters(0.5)};
+    CHECK_FALSE(scalr::within_bounds<unit_range>(nan_inside.begin(),
+                                                 nan_inside.end()));
+    samples[57] = meters(std::nan(""));
+    CHECK_FALSE(scalr::within_bounds<unit_range>(samples.begin(),
+                                                 samples.end()));
+    samples[57] = meters(0);
+    CHECK(scalr::within_bounds<unit_range>(samples.begin(), samples.end()));
+
+    // Wrapped bounds exclude the upper bound
+    using heading = scalr::bounded_quantity<degrees, std::ratio<0>,
+                                            std::ratio<360>,
+                                            scalr::wrap_bounds>;
+    std::vector<degrees> headings{degrees(0), degrees(359.5), degrees(90)};
+    CHECK(scalr::within_bounds<heading>(headings.begin(), headings.end()));
+    headings[2] = degrees(360);
+    CHECK_FALSE(
+        scalr::within_bounds<heading>(headings.begin(), headings.end()));
+
+    const auto first = unit_range::assume(samples[0]);
+    CHECK(first.value() == -1);
+  }
+}
@@ -0,0 +1,110 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Streaming Calculus") {
+  using time = scalr::duration<double>;
+
+  // Uneven timestamps over [0, 3] seconds
+  std::vector<time> ts;
+  for (double t : {0.0, 0.5, 1.0, 1.25, 1.5, 2.0, 2.5, 2.75, 3.0}) {
+    ts.push_back(time(t));
+  }
+
+  SECTION("Energy") {
+    STATIC_CHECK(std::is_same<scalr::quantity_product_t<scalr::watts, time>,
+                              scalr::joules>::value);
+    STATIC_CHECK(
+        std::is_same<scalr::kilowatt_hours::dimension,
+                     scalr::energy_dimension>::value);
+    CHECK(scalr::joules(scalr::kilowatt_hours(1)).value() == 3600000.0);
+
+    using namespace scalr::literals;
+    CHECK((2_kW * time(3)).value() == 6.0);
+    CHECK(scalr::joules(1.5_kJ).value() == 1500.0);
+  }
+
+  SECTION("Trapezoid") {
+    // Power rising linearly from 0 to 300 W
+    std::vector<scalr::watts> ps;
+    for (const auto& t : ts) {
+      ps.push_back(scalr::watts(100 * t.value()));
+    }
+
+    scalr::trapezoid_integrator<scalr::watts, time> whole;
+    whole.push(ts.begin(), ts.end(), ps.begin());
+    auto e = whole.value();
+
+    STATIC_CHECK(std::is_same<decltype(e), scalr::joules>::value);
+    CHECK(whole.count() == 9);
+    CHECK(e.value() == Catch::Approx(450.0));
+
+    // Chunk boundaries and single samples give the same result
+    scalr::trapezoid_integrator<scalr::watts, time> chunked;
+    chunked.push(ts.begin(), ts.begin() + 2, ps.begin());
+    chunked.push(ts[2], ps[2]);
+    chunked.push(ts.begin() + 3, ts.end(), ps.begin() + 3);
+    CHECK(chunked.value().value() == Catch::Approx(450.0));
+
+    // Samples in milliseconds and kilowatts integrate into joules
+    scalr::trapezoid_integrator<scalr::kilowatts, scalr::milliseconds> kw;
+    kw.push(scalr::milliseconds(0), scalr::kilowatts(2));
+    kw.push(scalr::milliseconds(500), scalr::kilowatts(2));
+    CHECK(scalr::joules(kw.value()).value() == Catch::Approx(1000.0));
+  }
+
+  SECTION("Simpson") {
+    // Simpson's rule is exact for cubics on any spacing: y = t^3 m
+    std::vector<scalr::meters> ys;
+    for (const auto& t : ts) {
+      ys.push_back(scalr::meters(t.value() * t.value() * t.value()));
+    }
+
+    scalr::simpson_integrator<scalr::meters, time> simpson;
+    simpson.push(ts.begin(), ts.end(), ys.begin());
+    CHECK(simpson.value().value() == Catch::Approx(81.0 / 4));
+
+    // An unpaired last interval is closed by the trapezoidal rule
+    scalr::simpson_integrator<scalr::meters, time> open;
+    open.push(ts.begin(), ts.begin() + 4, ys.begin());
+    const double panel = 1.0 / 4;
+    const double tail = (1.0 + 1.25 * 1.25 * 1.25) * 0.25 / 2;
+    CHECK(open.value().value() == Catch::Approx(panel + tail));
+  }
+
+  SECTION("Differentiation") {
+    // Position x = t^2 m gives speed 2t m/s
+    std::vector<scalr::meters> xs;
+    for (const auto& t : ts) {
+      xs.push_back(scalr::meters(t.value() * t.value()));
+    }
+
+    scalr::central_differentiator<scalr::meters, time> central;
+    std::vector<scalr::meters_per_second> vs(ts.size());
+    auto end = central(ts.begin(), ts.begin() + 5, xs.begin(), vs.begin());
+    end = central(ts.begin() + 5, ts.end(), xs.begin() + 5, end);
+
+    STATIC_CHECK(std::is_same<decltype(central)::result_type,
+                              scalr::meters_per_second>::value);
+    CHECK(end - vs.begin() == 7);
+    for (std::size_t i = 0; i < 7; ++i) {
+      CHECK(vs[i].value() == Catch::Approx(2 * ts[i + 1].value()));
+    }
+
+    // Backward differences of speed give the constant acceleration
+    scalr::backward_differentiator<scalr::meters_per_second, time> backward;
+    std::vector<scalr::meters_per_second_squared> as(7);
+    const auto last =
+        backward(ts.begin() + 1, ts.begin() + 8, vs.begin(), as.begin());
+
+    STATIC_CHECK(std::is_same<decltype(backward)::result_type,
+                              scalr::meters_per_second_squared>::value);
+    CHECK(last - as.begin() == 6);
+    for (std::size_t i = 0; i < 6; ++i) {
+      CHECK(as[i].value() == Catch::Approx(2.0));
+    }
+  }
+}
@@ -0,0 +1,144 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Compact Storage") {
+  SECTION("Scaled Integers") {
+    using millivolts16 =
+        scalr::scaled_quantity_t<scalr::volts, std::int16_t, std::milli>;
+    STATIC_CHECK(std::is_same<millivolts16::unit::ratio, std::milli>::value);
+
+    const std::vector<scalr::volts> source = {
+        scalr::volts(1.2344), scalr::volts(-0.0016), scalr::volts(40),
+        scalr::volts(-40), scalr::volts(std::nan(""))};
+    std::vector<millivolts16> stored(source.size());
+    const auto result =
+        scalr::narrow(source.begin(), source.end(), stored.begin());
+    CHECK(result.first == stored.end());
+    CHECK(result.second == 3);
+    CHECK(stored[0].value() == 1234);
+    CHECK(stored[1].value() == -2);
+    CHECK(stored[2].value() == 32767);
+    CHECK(stored[3].value() == -32768);
+    CHECK(stored[4].value() == 0);
+
+    std::vector<scalr::volts> restored(stored.size());
+    scalr::widen(stored.begin(), stored.end(), restored.begin());
+    CHECK(restored[0].value() == Catch::Approx(1.234));
+    CHECK(restored[1].value() == Catch::Approx(-0.002));
+    CHECK(restored[2].value() == Catch::Approx(32.767));
+  }
+
+  SECTION("Half Precision") {
+    using kelvins16 = scalr::quantity<scalr::float16, scalr::unit::kelvins>;
+    const std::vector<scalr::kelvins> source = {
+        scalr::kelvins(293.15), scalr::kelvins(-1.0), scalr::kelvins(65504),
+        scalr::kelvins(1e5), scalr::kelvins(6e-8), scalr::kelvins(0)};
+    std::vector<kelvins16> stored(source.size());
+    const auto result =
+        scalr::narrow(source.begin(), source.end(), stored.begin());
+    CHECK(result.second == 1);
+    CHECK(stored[1].value().bits == 0xbc00);
+    CHECK(stored[2].value().bits == 0x7bff);
+    CHECK(stored[3].value().bits == 0x7c00);
+    CHECK(stored[4].value().bits == 0x0001);
+    CHECK(stored[5].value().bits == 0x0000);
+
+    std::vector<scalr::kelvins> restored(stored.size());
+    scalr::widen(stored.begin(), stored.end(), restored.begin());
+    CHECK(restored[0].value() == 293.25);
+    CHECK(restored[1].value() == -1.0);
+    CHECK(restored[2].value() == 65504);
+    CHECK(std::isinf(restored[3].value()));
+    CHECK(restored[4].value() == Catch::Approx(5.9604645e-8));
+
+    // Every finite half precision value round-trips exactly
+    std::size_t mismatches = 0;
+    for (std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+      const std::uint16_t h = static_cast<std::uint16_t>(bits);
+      const float f = scalr::detail::float16_to_float(h);
+      mismatches += (bits & 0x7c00) != 0x7c00 &&
+                    scalr::detail::float_to_float16(f) != h;
+    }
+    CHECK(mismatches == 0);
+  }
+
+  SECTION("Brain Floating Point") {
+    using speed16 =
+        scalr::quantity<scalr::bfloat16, scalr::unit::kilometers_per_hour>;
+    const std::vector<scalr::meters_per_second> source = {
+        scalr::meters_per_second(10), scalr::meters_per_second(1e39)};
+    std::vector<speed16> stored(source.size());
+    const auto result =
+        scalr::narrow(source.begin(), source.end(), stored.begin());
+    CHECK(result.second == 1);
+    CHECK(stored[0].value().bits == 0x4210);
+
+    std::vector<scalr::meters_per_second> restored(stored.size());
+    scalr::widen(stored.begin(), stored.end(), restored.begin());
+    CHECK(restored[0].value() == Catch::Approx(10));
+    CHECK(std::isinf(restored[1].value()));
+  }
+}
+
+TEST_CASE("Compact Storage Throughput", "[!benchmark]") {
+  using millivolts16 =
+      scalr::scaled_quantity_t<scalr::volts, std::int16_t, std::milli>;
+  using volts16 = scalr::quantity<scalr::float16, scalr::unit::volts>;
+  const std::size_t n = 1 << 20;
+
+  std::vector<scalr::volts> samples(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    samples[i] = scalr::volts(std::sin(i * 0.001) * 10);
+  }
+  std::vector<millivolts16> scaled(n);
+  std::vector<volts16> halves(n);
+  scalr::narrow(samples.begin(), samples.end(), scaled.begin());
+  scalr::narrow(samples.begin(), samples.end(), halves.begin());
+
+  BENCHMARK("double sum") {
+    double sum = 0;
+    for (const scalr::volts& v : samples) {
+      sum += v.value();
+    }
+    return sum;
+  };
+
+  BENCHMARK("scaled int16 widen and sum") {
+    std::vector<scalr::volts> block(4096);
+    double sum = 0;
+    for (std::size_t i = 0; i < n; i += block.size()) {
+      scalr::widen(scaled.begin() + i, scaled.begin() + i + block.size(),
+                   block.begin());
+      for (const scalr::volts& v : block) {
+        sum += v.value();
+      }
+    }
+    return sum;
+  };
+
+  BENCHMARK("float16 widen and sum") {
+    std::vector<scalr::volts> block(4096);
+    double sum = 0;
+    for (std::size_t i = 0; i < n; i += block.size()) {
+      scalr::widen(halves.begin() + i, halves.begin() + i + block.size(),
+                   block.begin());
+      for (const scalr::volts& v : block) {
+        sum += v.value();
+      }
+    }
+    return sum;
+  };
+
+  BENCHMARK("scaled int16 narrow") {
+    return scalr::narrow(samples.begin(), samples.end(), scaled.begin())
+        .second;
+  };
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Compressed Series") {
+  using scalr::milliseconds;
+  using scalr::nanoseconds;
+
+  SECTION("Floating-Point Values") {
+    scalr::compressed_series<scalr::kelvins, milliseconds, 64> series;
+    std::vector<milliseconds> times;
+    std::vector<scalr::kelvins> values;
+    for (int i = 0; i < 1000; ++i) {
+      // A slowly drifting temperature read with 0.1 K resolution and a few
+      // irregular sampling intervals
+      times.push_back(milliseconds(1000 * i + (i % 97 == 0 ? 3 : 0)));
+      values.push_back(scalr::kelvins(293.1 + std::round(i / 50.0) / 10));
+    }
+    values[500] = scalr::kelvins(std::numeric_limits<double>::infinity());
+    values[501] = scalr::kelvins(-0.0);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      series.push_back(times[i], values[i]);
+    }
+
+    CHECK(series.size() == 1000);
+    CHECK(series.block_count() == 16);
+    CHECK(series.block_length(15) == 40);
+    CHECK(series.compressed_bytes() * 5 < 1000 * 16);
+
+    std::vector<milliseconds> decoded_times(series.size());
+    std::vector<scalr::kelvins> decoded_values(series.size());
+    const auto end =
+        series.decode(decoded_times.begin(), decoded_values.begin());
+    CHECK(end.first == decoded_times.end());
+    CHECK(decoded_times == times);
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      mismatches += scalr::detail::series_codec<double, 1>::to_word(
+                        decoded_values[i].value()) !=
+                    scalr::detail::series_codec<double, 1>::to_word(
+                        values[i].value());
+    }
+    CHECK(mismatches == 0);
+  }
+
+  SECTION("Integral Values") {
+    using centikelvins =
+        scalr::scaled_quantity_t<scalr::kelvins, std::int32_t, std::centi>;
+    scalr::compressed_series<centikelvins> series;
+    std::vector<nanoseconds> times;
+    std::vector<centikelvins> values;
+    for (int i = 0; i < 1050; ++i) {
+      times.push_back(nanoseconds(-5000000 + std::int64_t(i) * 250000));
+      values.push_back(centikelvins(29315 + (i % 7) - 3));
+    }
+    values[3] = centikelvins(std::numeric_limits<std::int32_t>::min());
+    values[4] = centikelvins(std::numeric_limits<std::int32_t>::max());
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      series.push_back(times[i], values[i]);
+    }
+    CHECK(series.block_count() == 2);
+    CHECK(series.compressed_bytes() * 5 < 1050 * 12);
+
+    std::vector<nanoseconds> decoded_times(series.size());
+    std::vector<centikelvins> decoded_values(series.size());
+    series.decode(decoded_times.begin(), decoded_values.begin());
+    CHECK(decoded_times == times);
+    CHECK(decoded_values == values);
+  }
+
+  SECTION("Block Access") {
+    using meters32 = scalr::quantity<float, scalr::unit::meters>;
+    scalr::compressed_series<meters32, milliseconds, 10> series;
+    for (int i = 0; i < 95; ++i) {
+      series.push_back(milliseconds(10 * i),
+                       scalr::millimeters(100.0 * std::sin(i * 0.1)));
+    }
+
+    CHECK(series.find_block(milliseconds(-5)) == 0);
+    CHECK(series.find_block(milliseconds(0)) == 0);
+    CHECK(series.find_block(milliseconds(455)) == 4);
+    CHECK(series.find_block(milliseconds(10000)) == 9);
+    CHECK(series.block_time(4) == milliseconds(400));
+
+    std::vector<milliseconds> times(series.block_length(9));
+    std::vector<meters32> values(times.size());
+    series.decode_block(9, times.begin(), values.begin());
+    CHECK(times.size() == 5);
+    CHECK(times.front() == milliseconds(900));
+    CHECK(times.back() == milliseconds(940));
+    CHECK(values.back() ==
+          meters32(scalr::millimeters(100.0 * std::sin(9.4))));
+  }
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "scalr/scalr.hpp"
+
+namespace constants = scalr::constants;
+
+TEST_CASE("Constants") {
+  SECTION("Exact Constants") {
+    constexpr auto weight = scalr::kilograms(80) * constants::standard_gravity;
+
+    STATIC_CHECK(std::is_same<decltype(weight)::dimension,
+                              scalr::force_dimension>::value);
+    STATIC_CHECK(std::is_same<decltype(weight)::ratio,
+                              std::ratio<196133, 20000>>::value);
+    STATIC_CHECK(weight.value() == 80);
+    STATIC_CHECK(weight == scalr::newtons(784.532));
+
+    constexpr auto distance = scalr::seconds(2) * constants::speed_of_light;
+
+    STATIC_CHECK(
+        std::is_same<decltype(distance)::unit,
+                     scalr::length_unit<std::ratio<299792458>>>::value);
+    STATIC_CHECK(distance.value() == 2);
+    STATIC_CHECK(scalr::meters(distance).value() == 599584916.0);
+
+    constexpr scalr::meters_per_second c = constants::speed_of_light;
+
+    STATIC_CHECK(c.value() == 299792458.0);
+
+    constexpr auto m = scalr::newtons(9.80665) / constants::standard_gravity;
+
+    CHECK(scalr::kilograms(m).value() == Catch::Approx(1.0));
+  }
+
+  SECTION("Inexact Constants") {
+    auto energy = scalr::kelvins(300) * constants::boltzmann;
+
+    STATIC_CHECK(std::is_same<decltype(energy)::value_type, double>::value);
+    CHECK(energy.value() == Catch::Approx(4.141947e-21));
+
+    auto charge = constants::faraday * scalr::amount_of_substance<double>(2);
+    using coulomb_unit = scalr::make_unit_t<decltype(charge)::dimension>;
+    using coulombs = scalr::quantity<double, coulomb_unit>;
+
+    CHECK(charge.value() == 2.0);
+    CHECK(coulombs(charge).value() == Catch::Approx(192970.66424662));
+    CHECK(constants::molar_gas.value() ==
+          Catch::Approx(constants::avogadro.value() *
+                        constants::boltzmann.value()));
+  }
+}
@@ -1,3 +1,6 @@
+#include <cfenv>
+#include <vector>
+
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
@@ -107,6 +110,38 @@ TEST_CASE("Units") {
                 scalr::make_unit_t<scalr::time_dimension, std::ratio<2, 5>>>>::
             value);
   }
+
+  SECTION("Wide Ratio Arithmetic") {
+    STATIC_CHECK(std::is_same<
+                 scalr::unit::picoseconds,
+                 scalr::unit_product_t<
+                     scalr::unit::picoseconds, scalr::unit::picoseconds,
+                     scalr::unit::picoseconds, scalr::unit::terahertz,
+                     scalr::unit::terahertz>>::value);
+
+    STATIC_CHECK(std::is_same<
+                 scalr::unit::terahertz,
+                 scalr::unit_exponent_t<scalr::unit::picoseconds, -1>>::value);
+
+    STATIC_CHECK(std::is_same<
+                 scalr::make_unit_t<scalr::volume_dimension, std::giga>,
+                 scalr::unit_exponent_t<scalr::unit::kilometers, 3>>::value);
+
+    using exameters = scalr::length<double, std::exa>;
+    using attometers = scalr::length<double, std::atto>;
+
+    CHECK(scalr::quantity_cast<attometers>(exameters(2.0)).value() ==
+          Catch::Approx(2e36));
+    CHECK(scalr::quantity_cast<exameters>(attometers(2e36)).value() ==
+          Catch::Approx(2.0));
+
+    // lcm(4294967291, 4294967279) exceeds intmax_t
+    using prime_unit1 = scalr::time_unit<std::ratio<1, 4294967291>>;
+    using prime_unit2 = scalr::time_unit<std::ratio<1, 4294967279>>;
+
+    CHECK(scalr::quantity<double, prime_unit1>(4294967291.0) ==
+          scalr::quantity<double, prime_unit2>(4294967279.0));
+  }
 }
 
 TEST_CASE("Quantities") {
@@ -148,6 +183,25 @@ TEST_CASE("Quantities") {
             value);
   }
   // SECTION("Comparison") { CHECK(scalr::hours{0.5} < scalr::hours{1}); }
+
+  SECTION("Mixed-Unit Operators") {
+    using int_kilometers = scalr::quantity<int, scalr::unit::kilometers>;
+    using int_miles = scalr::quantity<int, scalr::unit::miles>;
+
+    STATIC_CHECK(int_kilometers(1609344) == int_miles(1000000));
+    STATIC_CHECK(int_kilometers(1609345) > int_miles(1000000));
+    STATIC_CHECK(int_kilometers(1609343) < int_miles(1000000));
+
+    STATIC_CHECK(
+        std::is_same<decltype(scalr::hours(1) + scalr::seconds(1)),
+                     scalr::seconds>::value);
+    STATIC_CHECK((scalr::hours(1) + scalr::seconds(1)).value() == 3601);
+    STATIC_CHECK((scalr::seconds(1) - scalr::hours(1)).value() == -3599);
+    STATIC_CHECK(scalr::hours(1) / scalr::minutes(20) == 3);
+
+    CHECK(scalr::kilometers(1.609344) == scalr::miles(1.0));
+    CHECK((scalr::miles(1.0) - scalr::yards(1760.0)).value() == 0.0);
+  }
 }
 
 TEST_CASE("Named Quantities") {
@@ -210,6 +264,35 @@ TEST_CASE("Named Quantities") {
     CHECK(scalr::gradians(100) == scalr::reduced_radians(0.25));
   }
 
+  SECTION("Exact Pi Units") {
+    STATIC_CHECK(scalr::radians::pi == -1);
+    STATIC_CHECK(std::is_same<scalr::radians::ratio, std::ratio<1, 2>>::value);
+    STATIC_CHECK(scalr::radians(180_deg).value() == 3.141592653589793);
+    STATIC_CHECK(scalr::degrees(scalr::radians(3.141592653589793)).value() ==
+                 180.0);
+    STATIC_CHECK(scalr::reduced_radians(scalr::radians(2 * 3.141592653589793))
+                     .value() == 1.0);
+
+    for (int i = -720; i <= 720; i += 15) {
+      CHECK(scalr::degrees(scalr::radians(scalr::degrees(i))).value() ==
+            Catch::Approx(i).epsilon(1e-15).margin(1e-12));
+    }
+
+    using per_second = scalr::unit_inverse_t<scalr::unit::seconds>;
+    using radians_per_second = scalr::quantity<
+        double, scalr::unit_product_t<scalr::unit::radians, per_second>>;
+    auto angle = radians_per_second(3.0) * scalr::seconds(2);
+
+    STATIC_CHECK(std::is_same<decltype(angle), scalr::radians>::value);
+    CHECK(angle.value() == 6.0);
+    CHECK(scalr::radians(1.0) * scalr::radians(1.0) ==
+          scalr::quantity<double, scalr::unit_exponent_t<
+                                      scalr::unit::radians, 2>>(1.0));
+    CHECK(scalr::radians(3.141592653589793) + scalr::degrees(180) ==
+          scalr::reduced_radians(1.0));
+    CHECK(scalr::degrees(90) < scalr::radians(1.6));
+  }
+
   SECTION("Electric Current") {
     CHECK(4.2_mA == 4200_uA);
     CHECK(42_mA == 0.042_A);
@@ -245,6 +328,100 @@ TEST_CASE("Named Quantities") {
     CHECK(d.value() == 252000);
   }
 
+  SECTION("Rounding Conversion") {
+    STATIC_CHECK(scalr::quantity_cast<scalr::milliseconds>(
+                     scalr::nanoseconds(-1500000))
+                     .value() == -1);
+    STATIC_CHECK(
+        scalr::floor<scalr::milliseconds>(scalr::nanoseconds(-1500000))
+            .value() == -2);
+    STATIC_CHECK(
+        scalr::ceil<scalr::milliseconds>(scalr::nanoseconds(-1500000))
+            .value() == -1);
+    STATIC_CHECK(
+        scalr::round<scalr::milliseconds>(scalr::nanoseconds(-1500000))
+            .value() == -2);
+    STATIC_CHECK(
+        scalr::round<scalr::milliseconds>(scalr::nanoseconds(2500000))
+            .value() == 2);
+    STATIC_CHECK(scalr::round<scalr::minutes>(scalr::seconds(90)).value() ==
+                 2);
+    STATIC_CHECK(
+        scalr::floor<scalr::hours>(scalr::minutes(-1)).value() == -1);
+
+    // Floating sources rounded into integral targets
+    using int_seconds = scalr::quantity<long long, scalr::unit::seconds>;
+    using double_msecs = scalr::quantity<double, scalr::unit::milliseconds>;
+    CHECK(scalr::quantity_cast<int_seconds>(double_msecs(-1500.0)).value() ==
+          -1);
+    CHECK(scalr::floor<int_seconds>(double_msecs(-1500.0)).value() == -2);
+    CHECK(scalr::floor<int_seconds>(double_msecs(1500.0)).value() == 1);
+    CHECK(scalr::ceil<int_seconds>(double_msecs(1200.0)).value() == 2);
+    CHECK(scalr::ceil<int_seconds>(double_msecs(-1200.0)).value() == -1);
+    CHECK(scalr::round<int_seconds>(double_msecs(1700.0)).value() == 2);
+    CHECK(scalr::round<int_seconds>(double_msecs(2500.0)).value() == 2);
+    CHECK(scalr::round<int_seconds>(double_msecs(-3500.0)).value() == -4);
+
+    // Ties round to even whatever the floating-point rounding mode
+    for (int mode : {FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO}) {
+      std::fesetround(mode);
+      CHECK(scalr::round<int_seconds>(double_msecs(2500.0)).value() == 2);
+      CHECK(scalr::round<int_seconds>(double_msecs(-2500.0)).value() == -2);
+      CHECK(scalr::round<int_seconds>(double_msecs(3500.0)).value() == 4);
+      CHECK(scalr::round<int_seconds>(double_msecs(2600.0)).value() == 3);
+    }
+    std::fesetround(FE_TONEAREST);
+    using double_seconds = scalr::quantity<double, scalr::unit::seconds>;
+    CHECK(scalr::floor<int_seconds>(double_seconds(-0.5)).value() == -1);
+    CHECK(scalr::ceil<scalr::quantity<int, scalr::unit::milliseconds>>(
+              double_seconds(0.0012))
+              .value() == 2);
+
+    std::vector<scalr::nanoseconds> nsecs{
+        scalr::nanoseconds(999999), scalr::nanoseconds(1000000),
+        scalr::nanoseconds(-2000001), scalr::nanoseconds(INTMAX_MIN)};
+    std::vector<scalr::milliseconds> msecs(nsecs.size());
+
+    scalr::quantity_cast<scalr::milliseconds>(nsecs.begin(), nsecs.end(),
+                                              msecs.begin());
+
+    CHECK(msecs[0].value() == 0);
+    CHECK(msecs[1].value() == 1);
+    CHECK(msecs[2].value() == -2);
+    CHECK(msecs[3].value() == INTMAX_MIN / 1000000);
+
+    scalr::floor<scalr::milliseconds>(nsecs.begin(), nsecs.end(),
+                                      msecs.begin());
+
+    CHECK(msecs[0].value() == 0);
+    CHECK(msecs[2].value() == -3);
+  }
+
+  SECTION("Narrow Conversion") {
+    using mm16 = scalr::quantity<int16_t, scalr::unit::millimeters>;
+    using cm16 = scalr::quantity<int16_t, scalr::unit::centimeters>;
+    using mm32 = scalr::quantity<int32_t, scalr::unit::millimeters>;
+    using cm32 = scalr::quantity<int32_t, scalr::unit::centimeters>;
+
+    STATIC_CHECK(
+        std::is_same<scalr::quantity_cast_value_t<cm32, mm32>, int32_t>::value);
+    STATIC_CHECK(
+        std::is_same<scalr::quantity_cast_value_t<cm16, mm16>, int16_t>::value);
+    STATIC_CHECK(
+        std::is_same<scalr::quantity_cast_value_t<mm32, cm16>, int32_t>::value);
+    STATIC_CHECK(std::is_same<scalr::quantity_cast_value_t<mm32, cm32>,
+                              intmax_t>::value);
+    STATIC_CHECK(!scalr::quantity_type::cast<mm32, cm32>::is_narrow);
+    STATIC_CHECK(!scalr::quantity_type::cast<scalr::millimeters,
+                                             scalr::centimeters>::is_narrow);
+
+    STATIC_CHECK(scalr::quantity_cast<cm16>(mm16(-32768)).value() == -3276);
+    STATIC_CHECK(scalr::floor<cm16>(mm16(-32768)).value() == -3277);
+    STATIC_CHECK(scalr::quantity_cast<mm32>(cm16(32767)).value() == 327670);
+    STATIC_CHECK(scalr::quantity_cast<mm32>(cm32(-214748364)).value() ==
+                 -2147483640);
+  }
+
   SECTION("Quantity Arithmetic") {
     scalr::microseconds msecs = scalr::microseconds(1200);
     scalr::nanoseconds nsecs = scalr::nanoseconds(1200);
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Threshold Kernels") {
+  using namespace scalr::literals;
+  using scalr::comparison;
+  using scalr::meters_per_second;
+
+  std::vector<meters_per_second> speeds;
+  for (int i = 0; i < 100; ++i) {
+    speeds.push_back(meters_per_second(i * 0.5));
+  }
+
+  SECTION("Compare") {
+    // 36 kph is exactly 10 m/s
+    std::vector<bool> over(speeds.size());
+    scalr::compare(speeds.begin(), speeds.end(), over.begin(),
+                   comparison::greater, 36_kph);
+    CHECK_FALSE(over[20]);
+    CHECK(over[21]);
+
+    std::vector<char> at(speeds.size());
+    scalr::compare(speeds.begin(), speeds.end(), at.begin(),
+                   comparison::equal, 36_kph);
+    CHECK(at[20]);
+    CHECK_FALSE(at[21]);
+
+    CHECK(scalr::count_if(speeds.begin(), speeds.end(), comparison::greater,
+                          36_kph) == 79);
+    CHECK(scalr::count_if(speeds.begin(), speeds.end(),
+                          comparison::greater_equal, 36_kph) == 80);
+    CHECK(scalr::count_if(speeds.begin(), speeds.end(), comparison::less,
+                          36_kph) == 20);
+    CHECK(scalr::count_if(speeds.begin(), speeds.end(),
+                          comparison::less_equal, 36_kph) == 21);
+    CHECK(scalr::count_if(speeds.begin(), speeds.end(), comparison::not_equal,
+                          36_kph) == 99);
+  }
+
+  SECTION("Integral Arrays") {
+    using mm = scalr::quantity<int, scalr::unit::millimeters>;
+    std::vector<mm> lengths;
+    for (int i = -10; i <= 10; ++i) {
+      lengths.push_back(mm(i));
+    }
+    // Thresholds between integers of the array are rounded, not truncated
+    CHECK(scalr::count_if(lengths.begin(), lengths.end(), comparison::less,
+                          scalr::micrometers(-2500)) == 8);
+    CHECK(scalr::count_if(lengths.begin(), lengths.end(), comparison::greater,
+                          scalr::micrometers(2500)) == 8);
+    CHECK(scalr::count_if(lengths.begin(), lengths.end(), comparison::equal,
+                          scalr::micrometers(2500)) == 0);
+    CHECK(scalr::count_if(lengths.begin(), lengths.end(),
+                          comparison::not_equal,
+                          scalr::micrometers(2500)) == 21);
+    CHECK(scalr::count_if(lengths.begin(), lengths.end(), comparison::greater,
+                          scalr::kilometers(1)) == 0);
+    CHECK(scalr::count_if(lengths.begin(), lengths.end(), comparison::greater,
+                          scalr::kilometers(-1e9)) == 21);
+
+    std::vector<mm> clamped(lengths.size());
+    scalr::clamp(lengths.begin(), lengths.end(), clamped.begin(),
+                 scalr::micrometers(-2500), scalr::centimeters(0.35));
+    CHECK(clamped.front() == mm(-2));
+    CHECK(clamped[10] == mm(0));
+    CHECK(clamped.back() == mm(3));
+  }
+
+  SECTION("Masks") {
+    std::vector<std::uint64_t> words(2, ~std::uint64_t(0));
+    const auto end = scalr::compare_mask(speeds.begin(), speeds.end(),
+                                         words.begin(), comparison::less,
+                                         36_kph);
+    CHECK(end == words.end());
+    CHECK(words[0] == (std::uint64_t(1) << 20) - 1);
+    CHECK(words[1] == 0);
+
+    scalr::compare_mask(speeds.begin(), speeds.end(), words.begin(),
+                        comparison::greater_equal, 36_kph);
+    CHECK(words[0] == ~((std::uint64_t(1) << 20) - 1));
+    CHECK(words[1] == (std::uint64_t(1) << 36) - 1);
+  }
+
+  SECTION("Select and Range") {
+    std::vector<meters_per_second> fast;
+    scalr::select(speeds.begin(), speeds.end(), std::back_inserter(fast),
+                  comparison::greater, 162_kph);
+    REQUIRE(fast.size() == 9);
+    CHECK(fast.front() == meters_per_second(45.5));
+
+    std::vector<bool> inside(speeds.size());
+    scalr::in_range(speeds.begin(), speeds.end(), inside.begin(), 18_kph,
+                    36_kph);
+    CHECK_FALSE(inside[9]);
+    CHECK(inside[10]);
+    CHECK(inside[20]);
+    CHECK_FALSE(inside[21]);
+
+    std::vector<meters_per_second> clamped(speeds.size());
+    scalr::clamp(speeds.begin(), speeds.end(), clamped.begin(), 18_kph,
+                 36_kph);
+    CHECK(clamped.front() == meters_per_second(5));
+    CHECK(clamped[15] == meters_per_second(7.5));
+    CHECK(clamped.back() == meters_per_second(10));
+  }
+}
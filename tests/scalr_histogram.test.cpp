@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Log Histogram") {
+  using histogram = scalr::log_histogram<scalr::nanoseconds>;
+
+  SECTION("Buckets") {
+    // Tick counts below 2^(Precision + 1) have buckets of their own
+    CHECK(histogram::bucket_index(0) == 0);
+    CHECK(histogram::bucket_index(63) == 63);
+    CHECK(histogram::bucket_lower(63) == 63);
+
+    // Larger counts share buckets within 1/32 of their magnitude
+    CHECK(histogram::bucket_index(64) == 64);
+    CHECK(histogram::bucket_index(65) == 64);
+    CHECK(histogram::bucket_lower(64) == 64);
+    CHECK(histogram::bucket_width(64) == 2);
+
+    for (std::uint64_t v : {std::uint64_t(100), std::uint64_t(12345678),
+                            std::uint64_t(1) << 40,
+                            ~std::uint64_t(0)}) {
+      const std::size_t i = histogram::bucket_index(v);
+      CHECK(i < histogram::bucket_count);
+      CHECK(histogram::bucket_lower(i) <= v);
+      CHECK(v - histogram::bucket_lower(i) < histogram::bucket_width(i));
+      CHECK(histogram::bucket_width(i) <= (v >> 5) + 1);
+    }
+  }
+
+  SECTION("Percentiles") {
+    histogram h;
+    for (int i = 1; i <= 1000; ++i) {
+      h.record(scalr::microseconds(i));
+    }
+
+    CHECK(h.count() == 1000);
+    CHECK(h.min().value() == 1000);
+    CHECK(h.max<scalr::microseconds>().value() == 1000);
+
+    // Percentiles are accurate to the bucket resolution
+    const auto p50 = h.percentile<scalr::duration<double, std::micro>>(50);
+    CHECK(p50.value() >= 500);
+    CHECK(p50.value() <= 500 * (1 + 1.0 / 32));
+    CHECK(h.percentile(100).value() == 1000000);
+    CHECK(h.percentile<scalr::microseconds>(0).value() == 1);
+  }
+
+  SECTION("Percentile Ranks") {
+    // Percentiles round the rank up: the median of three samples is the
+    // second one and tail percentiles reach the largest samples
+    histogram odd;
+    for (int i : {10, 20, 30}) {
+      odd.record(scalr::nanoseconds(i));
+    }
+    CHECK(odd.percentile(50).value() == 20);
+    CHECK(odd.percentile(34).value() == 20);
+    CHECK(odd.percentile(33).value() == 10);
+    CHECK(odd.percentile(99).value() == 30);
+
+    histogram ten;
+    for (int i = 1; i <= 10; ++i) {
+      ten.record(scalr::nanoseconds(i));
+    }
+    CHECK(ten.percentile(90).value() == 9);
+    CHECK(ten.percentile(95).value() == 10);
+    CHECK(ten.percentile(99.9).value() == 10);
+    CHECK(ten.percentile(10).value() == 1);
+    CHECK(ten.percentile(11).value() == 2);
+
+    histogram one;
+    one.record(scalr::nanoseconds(7));
+    CHECK(one.percentile(0).value() == 7);
+    CHECK(one.percentile(50).value() == 7);
+  }
+
+  SECTION("Merge and serialize") {
+    histogram a, b;
+    a.record(scalr::nanoseconds(10), 3);
+    b.record(scalr::milliseconds(2));
+    b.record(scalr::nanoseconds(-5));
+    a.merge(b);
+
+    CHECK(a.count() == 5);
+    CHECK(a.min().value() == 0);
+    CHECK(a.max<scalr::milliseconds>().value() == 2);
+
+    const std::vector<std::uint8_t> bytes = a.serialize();
+    CHECK(bytes.size() < 20);
+
+    histogram c;
+    CHECK(c.deserialize(bytes.begin(), bytes.end()));
+    CHECK(c.count() == 5);
+    CHECK(c.serialize() == bytes);
+    CHECK(c.percentile(50).value() == 10);
+
+    // Truncated input or another precision is rejected
+    CHECK_FALSE(c.deserialize(bytes.begin(), bytes.end() - 1));
+    scalr::log_histogram<scalr::nanoseconds, 7> other;
+    CHECK_FALSE(other.deserialize(bytes.begin(), bytes.end()));
+    CHECK(c.count() == 5);
+  }
+}
@@ -0,0 +1,88 @@
+#include <cmath>
+#include <cstddef>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "scalr/scalr.hpp"
+
+namespace {
+
+using positions = scalr::quantity_vector<double, scalr::unit::meters>;
+using velocities =
+    scalr::quantity_vector<double, scalr::unit::meters_per_second>;
+using accelerations = scalr::quantity_vector<
+    double, scalr::unit::meters_per_second_squared>;
+using time_step = scalr::duration<double>;
+
+// Harmonic oscillator with unit angular frequency: a = -x
+struct spring {
+  template <class XIt, class AIt>
+  void operator()(XIt x_first, XIt x_last, AIt a_first) const {
+    for (; x_first != x_last; ++x_first, ++a_first) {
+      *a_first = scalr::meters_per_second_squared(-x_first->value());
+    }
+  }
+
+  template <class XIt, class VIt, class AIt>
+  void operator()(XIt x_first, XIt x_last, VIt, AIt a_first) const {
+    (*this)(x_first, x_last, a_first);
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Integrators") {
+  SECTION("Euler") {
+    STATIC_CHECK(sizeof(positions::value_type) == sizeof(double));
+
+    positions x(4, scalr::meters(0));
+    velocities v(4, scalr::meters_per_second(1));
+    accelerations a(4, scalr::meters_per_second_squared(-10));
+
+    for (int i = 0; i < 10; ++i) {
+      scalr::euler_step(x.begin(), x.end(), v.begin(), a.begin(),
+                        time_step(0.1));
+    }
+
+    CHECK(v[3].value() == Catch::Approx(-9.0));
+    CHECK(x[3].value() == Catch::Approx(1.0 - 5.5));
+
+    // Steps in milliseconds are converted through the kinematic chain
+    scalr::euler_step(x.begin(), x.end(), v.begin(), a.begin(),
+                      scalr::duration<double, std::milli>(100));
+
+    CHECK(v[0].value() == Catch::Approx(-10.0));
+  }
+
+  SECTION("Verlet") {
+    positions x(2, scalr::meters(1));
+    velocities v(2, scalr::meters_per_second(0));
+    accelerations a(2);
+    spring()(x.begin(), x.end(), a.begin());
+
+    const time_step dt(0.001);
+    for (int i = 0; i < 1000; ++i) {
+      scalr::verlet_step(x.begin(), x.end(), v.begin(), a.begin(), dt,
+                         spring());
+    }
+
+    CHECK(x[1].value() == Catch::Approx(std::cos(1.0)).epsilon(1e-6));
+    CHECK(v[1].value() == Catch::Approx(-std::sin(1.0)).epsilon(1e-6));
+  }
+
+  SECTION("Runge-Kutta") {
+    positions x(3, scalr::meters(1));
+    velocities v(3, scalr::meters_per_second(0));
+    scalr::rk4_integrator<positions::value_type, velocities::value_type,
+                          accelerations::value_type>
+        rk4;
+
+    for (int i = 0; i < 100; ++i) {
+      rk4.step(x.begin(), x.end(), v.begin(), time_step(0.01), spring());
+    }
+
+    CHECK(x[2].value() == Catch::Approx(std::cos(1.0)).epsilon(1e-9));
+    CHECK(v[2].value() == Catch::Approx(-std::sin(1.0)).epsilon(1e-9));
+  }
+}
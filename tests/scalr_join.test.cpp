@@ -0,0 +1,77 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("As-of Join") {
+  using ms = scalr::milliseconds;
+  using us = scalr::microseconds;
+
+  // Speed at 0, 10, 20, 30 ms joined onto currents sampled in microseconds
+  std::vector<ms> speed_times{ms(0), ms(10), ms(20), ms(30)};
+  std::vector<scalr::meters_per_second> speeds{
+      scalr::meters_per_second(0), scalr::meters_per_second(1),
+      scalr::meters_per_second(2), scalr::meters_per_second(3)};
+  std::vector<us> times{us(-5000), us(10000), us(12000), us(18000),
+                        us(29000), us(45000)};
+
+  std::vector<scalr::meters_per_second> out(times.size());
+  std::vector<bool> matched(times.size());
+
+  auto join = [&](scalr::join_mode mode, ms tolerance) {
+    scalr::asof_join(times.begin(), times.end(), speed_times.begin(),
+                     speed_times.end(), speeds.begin(), out.begin(),
+                     matched.begin(), tolerance, mode);
+  };
+
+  SECTION("Backward") {
+    join(scalr::join_mode::backward, ms(5));
+    CHECK(matched == std::vector<bool>{false, true, true, false, false,
+                                       false});
+    CHECK(out[1].value() == 1.0);
+    CHECK(out[2].value() == 1.0);
+    CHECK(out[3].value() == 0.0);
+
+    join(scalr::join_mode::backward, scalr::seconds(1));
+    CHECK(matched[3]);
+    CHECK(out[3].value() == 1.0);
+    CHECK(out[5].value() == 3.0);
+  }
+
+  SECTION("Forward") {
+    join(scalr::join_mode::forward, ms(5));
+    CHECK(matched == std::vector<bool>{true, true, false, true, true,
+                                       false});
+    CHECK(out[0].value() == 0.0);
+    CHECK(out[1].value() == 1.0);
+    CHECK(out[3].value() == 2.0);
+    CHECK(out[4].value() == 3.0);
+  }
+
+  SECTION("Nearest") {
+    join(scalr::join_mode::nearest, ms(5));
+    CHECK(matched == std::vector<bool>{true, true, true, true, true, false});
+    CHECK(out[2].value() == 1.0);
+    CHECK(out[3].value() == 2.0);
+    CHECK(out[4].value() == 3.0);
+  }
+
+  SECTION("Linear") {
+    join(scalr::join_mode::linear, ms(10));
+    CHECK(matched == std::vector<bool>{false, true, true, true, true, false});
+    CHECK(out[1].value() == 1.0);
+    CHECK(out[2].value() == Catch::Approx(1.2));
+    CHECK(out[3].value() == Catch::Approx(1.8));
+    CHECK(out[4].value() == Catch::Approx(2.9));
+  }
+
+  SECTION("Empty") {
+    std::vector<ms> none;
+    scalr::asof_join(times.begin(), times.end(), none.begin(), none.end(),
+                     speeds.begin(), out.begin(), matched.begin(), ms(5),
+                     scalr::join_mode::nearest);
+    CHECK(matched == std::vector<bool>(times.size(), false));
+  }
+}
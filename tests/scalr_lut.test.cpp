@@ -0,0 +1,168 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Lookup Tables") {
+  using time = scalr::duration<double>;
+  using milliseconds = scalr::duration<double, std::ratio<1, 1000>>;
+
+  // Samples of y = x^2 meters at x = 0, 1, 2, 3, 4 seconds
+  std::vector<scalr::meters> ys;
+  for (int i = 0; i < 5; ++i) {
+    ys.push_back(scalr::meters(i * i));
+  }
+  const scalr::quantity_lut<time, scalr::meters> lut(time(0), time(1), ys);
+
+  SECTION("Uniform") {
+    CHECK(lut.uniform());
+    CHECK(lut.size() == 5);
+    CHECK(lut(time(2)).value() == 4.0);
+    CHECK(lut(time(2.5)).value() == 6.5);
+    CHECK(lut(time(2.5), scalr::interpolation::nearest).value() == 9.0);
+    CHECK(lut(time(2.4), scalr::interpolation::nearest).value() == 4.0);
+
+    // Arguments in other units are converted once
+    CHECK(lut(milliseconds(1500)).value() == 2.5);
+
+    // Arguments outside the grid are clamped to its ends
+    CHECK(lut(time(-1)).value() == 0.0);
+    CHECK(lut(time(9)).value() == 16.0);
+  }
+
+  SECTION("Cubic") {
+    // Central-difference slopes are exact for a parabola at interior points
+    CHECK(lut(time(2.5), scalr::interpolation::cubic).value() ==
+          Catch::Approx(6.25));
+    CHECK(lut(time(3), scalr::interpolation::cubic).value() == 9.0);
+  }
+
+  SECTION("Derivative") {
+    auto v = lut.derivative(time(2.5));
+
+    STATIC_CHECK(
+        std::is_same<decltype(v)::dimension, scalr::speed_dimension>::value);
+    CHECK(v.value() == 5.0);
+    CHECK(lut.derivative(time(2.5), scalr::interpolation::cubic).value() ==
+          Catch::Approx(5.0));
+  }
+
+  SECTION("Non-uniform") {
+    std::vector<time> xs{time(0), time(1), time(3), time(4)};
+    std::vector<scalr::meters> zs{scalr::meters(0), scalr::meters(1),
+                                  scalr::meters(9), scalr::meters(16)};
+    const scalr::quantity_lut<time, scalr::meters> sparse(xs, zs);
+
+    CHECK_FALSE(sparse.uniform());
+    CHECK(sparse(time(2)).value() == 5.0);
+    CHECK(sparse(time(3.5)).value() == 12.5);
+    CHECK(sparse(time(5)).value() == 16.0);
+    CHECK(sparse.derivative(time(0.5)).value() == 1.0);
+  }
+
+  SECTION("Batch") {
+    std::vector<time> xs;
+    for (int i = -2; i < 20; ++i) {
+      xs.push_back(time(0.25 * i));
+    }
+    std::vector<scalr::meters> linear(xs.size());
+    std::vector<scalr::meters> cubic(xs.size());
+    lut(xs.begin(), xs.end(), linear.begin());
+    lut(xs.begin(), xs.end(), cubic.begin(), scalr::interpolation::cubic);
+
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      CHECK(linear[i].value() == lut(xs[i]).value());
+      CHECK(cubic[i].value() ==
+            lut(xs[i], scalr::interpolation::cubic).value());
+    }
+  }
+
+  SECTION("Invalid Input") {
+    // NaN arguments never index the table and give NaN
+    const time nan(std::nan(""));
+    CHECK(std::isnan(lut(nan).value()));
+    CHECK(std::isnan(lut(nan, scalr::interpolation::nearest).value()));
+    CHECK(std::isnan(lut(nan, scalr::interpolation::cubic).value()));
+    CHECK(std::isnan(lut.derivative(nan).value()));
+
+    std::vector<time> xs{time(1), nan, time(2)};
+    std::vector<scalr::meters> out(xs.size());
+    lut(xs.begin(), xs.end(), out.begin());
+    CHECK(out[0].value() == 1.0);
+    CHECK(std::isnan(out[1].value()));
+    CHECK(out[2].value() == 4.0);
+
+    const scalr::quantity_lut<time, scalr::meters> sparse(
+        std::vector<time>{time(0), time(1), time(3)},
+        std::vector<scalr::meters>{scalr::meters(0), scalr::meters(1),
+                                   scalr::meters(9)});
+    CHECK(std::isnan(sparse(nan).value()));
+
+    // Tables too small or with mismatched sizes are rejected
+    using table = scalr::quantity_lut<time, scalr::meters>;
+    const std::vector<scalr::meters> one{scalr::meters(1)};
+    CHECK_THROWS_AS(table(time(0), time(1), one), std::invalid_argument);
+    CHECK_THROWS_AS(table(std::vector<time>{time(0)}, one),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(table(std::vector<time>{time(0), time(1)}, ys),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(table(std::vector<time>(), std::vector<scalr::meters>()),
+                    std::invalid_argument);
+
+    using grid = scalr::quantity_lut2<time, time, scalr::meters>;
+    CHECK_THROWS_AS(grid(time(0), time(1), 3, time(0), time(1), ys),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(grid(time(0), time(1), 5, time(0), time(1), ys),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(grid(time(0), time(1), 0, time(0), time(1), ys),
+                    std::invalid_argument);
+    const grid square(time(0), time(1), 2, time(0), time(1),
+                      std::vector<scalr::meters>(4, scalr::meters(1)));
+    CHECK(std::isnan(square(nan, time(0)).value()));
+    CHECK(std::isnan(square(time(0), nan, scalr::interpolation::cubic)
+                         .value()));
+  }
+
+  SECTION("Two-dimensional") {
+    // z = x + 10 y meters on a 3 x 2 grid
+    std::vector<scalr::meters> zs;
+    for (int j = 0; j < 2; ++j) {
+      for (int i = 0; i < 3; ++i) {
+        zs.push_back(scalr::meters(i + 10 * j));
+      }
+    }
+    const scalr::quantity_lut2<time, time, scalr::meters> grid(
+        time(0), time(1), 3, time(0), time(2), zs);
+
+    CHECK(grid(time(1.5), time(1)).value() == 6.5);
+    CHECK(grid(time(1.5), time(1.2), scalr::interpolation::nearest).value() ==
+          12.0);
+    CHECK(grid(time(5), time(-1)).value() == 2.0);
+  }
+
+  SECTION("Bicubic") {
+    // z = x^2 + y^2 meters on a 6 x 5 grid. Central-difference slopes make
+    // bicubic interpolation exact for quadratics away from the edges.
+    std::vector<scalr::meters> zs;
+    for (int j = 0; j < 5; ++j) {
+      for (int i = 0; i < 6; ++i) {
+        zs.push_back(scalr::meters(i * i + j * j));
+      }
+    }
+    const scalr::quantity_lut2<time, time, scalr::meters> grid(
+        time(0), time(1), 6, time(0), time(1), zs);
+    const auto cubic = scalr::interpolation::cubic;
+
+    CHECK(grid(time(2.5), time(2.5), cubic).value() == Catch::Approx(12.5));
+    CHECK(grid(time(2.5), time(2.5)).value() == Catch::Approx(13.0));
+    CHECK(grid(time(1.25), time(2.75), cubic).value() ==
+          Catch::Approx(1.5625 + 7.5625));
+    CHECK(grid(time(3), time(2), cubic).value() == Catch::Approx(13.0));
+    CHECK(grid(time(0), time(4), cubic).value() == Catch::Approx(16.0));
+    CHECK(grid(time(9), time(9), cubic).value() == Catch::Approx(41.0));
+  }
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Math Functions") {
+  SECTION("Powers") {
+    constexpr auto a = scalr::pow<2>(scalr::meters(3));
+    constexpr auto v = scalr::pow<3>(scalr::length<int>(2));
+    constexpr auto f = scalr::pow<-1>(scalr::duration<double>(0.5));
+
+    STATIC_CHECK(std::is_same<decltype(a), const scalr::square_meters>::value);
+    STATIC_CHECK(a.value() == 9.0);
+    STATIC_CHECK(std::is_same<decltype(v)::dimension,
+                              scalr::volume_dimension>::value);
+    STATIC_CHECK(v.value() == 8);
+    STATIC_CHECK(std::is_same<decltype(f)::dimension,
+                              scalr::frequency_dimension>::value);
+    STATIC_CHECK(f.value() == 2.0);
+    STATIC_CHECK(scalr::pow<0>(scalr::meters(3)).value() == 1.0);
+    STATIC_CHECK(scalr::pow<5>(scalr::length<long>(3)).value() == 243);
+  }
+
+  SECTION("Roots") {
+    auto side = scalr::sqrt(scalr::square_meters(16));
+
+    STATIC_CHECK(std::is_same<decltype(side), scalr::meters>::value);
+    CHECK(side.value() == 4.0);
+
+    auto hm = scalr::sqrt(scalr::hectares(4));
+
+    STATIC_CHECK(std::is_same<decltype(hm),
+                              scalr::length<double, std::ratio<100>>>::value);
+    CHECK(hm.value() == 2.0);
+
+    // Ratios without an exact root are converted to the coherent unit first
+    auto l = scalr::sqrt(scalr::area<double, std::ratio<2>>(8));
+
+    STATIC_CHECK(std::is_same<decltype(l), scalr::meters>::value);
+    CHECK(l.value() == 4.0);
+
+    auto r = scalr::sqrt(scalr::radians(4.0) * scalr::radians(1.0));
+
+    STATIC_CHECK(std::is_same<decltype(r), scalr::radians>::value);
+    CHECK(r.value() == 2.0);
+
+    auto edge = scalr::cbrt(scalr::pow<3>(scalr::centimeters(3)));
+
+    STATIC_CHECK(std::is_same<decltype(edge), scalr::centimeters>::value);
+    CHECK(edge.value() == Catch::Approx(3.0));
+    CHECK(scalr::meters(scalr::cbrt(scalr::volume<double>(27))).value() ==
+          Catch::Approx(3.0));
+
+    auto speed = scalr::sqrt(scalr::meters(2) *
+                             scalr::meters_per_second_squared(8));
+
+    STATIC_CHECK(std::is_same<decltype(speed)::dimension,
+                              scalr::speed_dimension>::value);
+    CHECK(speed.value() == 4.0);
+  }
+
+  SECTION("Hypot and FMA") {
+    auto d = scalr::hypot(scalr::meters(3), scalr::centimeters(400));
+
+    STATIC_CHECK(std::is_same<decltype(d), scalr::centimeters>::value);
+    CHECK(d.value() == Catch::Approx(500.0));
+    CHECK(scalr::hypot(scalr::meters(3e200), scalr::meters(4e200)).value() ==
+          Catch::Approx(5e200));
+
+    auto x = scalr::fma(scalr::meters_per_second(2), scalr::duration<double>(3),
+                        scalr::meters(1));
+
+    STATIC_CHECK(std::is_same<decltype(x), scalr::meters>::value);
+    CHECK(x.value() == 7.0);
+
+    auto y = scalr::fma(scalr::meters_per_second(2), scalr::duration<double>(3),
+                        scalr::kilometers(1));
+
+    CHECK(scalr::meters(y).value() == 1006.0);
+    CHECK(scalr::fma(scalr::length<int>(2), scalr::length<int>(3),
+                     scalr::area<int>(4))
+              .value() == 10);
+  }
+}
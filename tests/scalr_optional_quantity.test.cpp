@@ -0,0 +1,111 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Optional Quantities") {
+  using scalr::meters;
+  using optional_meters = scalr::optional_quantity<double, scalr::unit::meters>;
+  using optional_steps = scalr::optional_quantity<int, scalr::unit::meters>;
+
+  SECTION("Values") {
+    STATIC_CHECK(sizeof(optional_meters) == sizeof(double));
+    STATIC_CHECK(sizeof(optional_steps) == sizeof(int));
+
+    const optional_meters empty;
+    const optional_meters one = meters(1);
+    const optional_meters centimeter = scalr::centimeters(1);
+    CHECK_FALSE(empty.has_value());
+    CHECK_FALSE(empty);
+    CHECK(one);
+    CHECK(*one == meters(1));
+    CHECK(centimeter.value_or(meters(5)) == meters(0.01));
+    CHECK(empty.value_or(meters(5)) == meters(5));
+    CHECK(empty == optional_meters());
+    CHECK(empty != one);
+    CHECK(one != centimeter);
+
+    // Computed NaNs are values, not empty markers
+    const optional_meters nan = meters(std::nan(""));
+    const optional_meters quotient = meters(0.0 / std::sqrt(0.0));
+    CHECK(nan.has_value());
+    CHECK(quotient.has_value());
+
+    optional_steps steps = scalr::quantity<int, scalr::unit::meters>(-3);
+    CHECK(steps);
+    steps.reset();
+    CHECK_FALSE(steps);
+    CHECK(steps.raw() == std::numeric_limits<int>::lowest());
+  }
+
+  SECTION("Reductions") {
+    std::vector<optional_meters> samples(10);
+    CHECK(scalr::count_present(samples.begin(), samples.end()) == 0);
+    CHECK(scalr::sum_present(samples.begin(), samples.end()) == meters(0));
+    CHECK_FALSE(scalr::min_present(samples.begin(), samples.end()));
+
+    samples[1] = meters(4);
+    samples[6] = meters(-2.5);
+    samples[9] = meters(1);
+    CHECK(scalr::count_present(samples.begin(), samples.end()) == 3);
+    CHECK(scalr::sum_present(samples.begin(), samples.end()) == meters(2.5));
+    CHECK(*scalr::min_present(samples.begin(), samples.end()) ==
+          meters(-2.5));
+    CHECK(*scalr::max_present(samples.begin(), samples.end()) == meters(4));
+
+    std::vector<optional_steps> steps(7);
+    steps[2] = scalr::quantity<int, scalr::unit::meters>(-7);
+    steps[5] = scalr::quantity<int, scalr::unit::meters>(3);
+    CHECK(scalr::sum_present(steps.begin(), steps.end()).value() == -4);
+    CHECK((*scalr::min_present(steps.begin(), steps.end())).value() == -7);
+    CHECK((*scalr::max_present(steps.begin(), steps.end())).value() == 3);
+  }
+}
+
+TEST_CASE("Nullable Columns") {
+  using scalr::comparison;
+  using scalr::meters;
+  using column_type = scalr::nullable_vector<double, scalr::unit::meters>;
+
+  column_type column;
+  for (int i = 0; i < 150; ++i) {
+    if (i % 3 == 0) {
+      column.push_back_null();
+    } else {
+      column.push_back(meters(i - 75));
+    }
+  }
+  column.push_back(scalr::optional_quantity<double, scalr::unit::meters>());
+
+  CHECK(column.size() == 151);
+  CHECK(column.validity().size() == 3);
+  CHECK_FALSE(column.has_value(0));
+  CHECK(column.has_value(1));
+  CHECK_FALSE(column[150]);
+  CHECK(*column[1] == meters(-74));
+
+  CHECK(scalr::count_present(column) == 100);
+  double expected = 0;
+  for (int i = 0; i < 150; ++i) {
+    expected += i % 3 == 0 ? 0 : i - 75;
+  }
+  CHECK(scalr::sum_present(column).value() == Catch::Approx(expected));
+  CHECK(*scalr::min_present(column) == meters(-74));
+  CHECK(*scalr::max_present(column) == meters(74));
+  CHECK_FALSE(scalr::min_present(column_type()));
+
+  // Empty elements hold zero but never compare true
+  std::vector<std::uint64_t> mask(column.validity().size());
+  scalr::compare_mask(column, mask.begin(), comparison::less_equal,
+                      scalr::kilometers(0));
+  CHECK((mask[0] & 1) == 0);
+  CHECK((mask[0] & 2) == 2);
+  CHECK(scalr::count_if(column, comparison::less_equal,
+                        scalr::kilometers(0)) == 50);
+  CHECK(scalr::count_if(column, comparison::not_equal, meters(1)) == 99);
+}
@@ -0,0 +1,106 @@
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "scalr/scalr.hpp"
+
+namespace {
+
+using position = scalr::quantity_vec3<double, scalr::unit::meters>;
+using velocity = scalr::quantity_vec3<double, scalr::unit::meters_per_second>;
+using acceleration =
+    scalr::quantity_vec3<double, scalr::unit::meters_per_second_squared>;
+
+}  // namespace
+
+TEST_CASE("Quantity Vectors") {
+  SECTION("Layout") {
+    STATIC_CHECK(sizeof(position) == 4 * sizeof(double));
+    STATIC_CHECK(alignof(position) == 16);
+    STATIC_CHECK(sizeof(scalr::quantity_vec2<float, scalr::unit::meters>) ==
+                 2 * sizeof(float));
+    STATIC_CHECK(position::size() == 3);
+  }
+
+  SECTION("Arithmetic") {
+    position p(scalr::meters(1), scalr::meters(2), scalr::meters(3));
+    position q(scalr::meters(3), scalr::meters(2), scalr::meters(1));
+
+    CHECK(p + q == position(scalr::meters(4), scalr::meters(4),
+                            scalr::meters(4)));
+    CHECK(p - q == position(scalr::meters(-2), scalr::meters(0),
+                            scalr::meters(2)));
+    CHECK(-p == position(scalr::meters(-1), scalr::meters(-2),
+                         scalr::meters(-3)));
+    CHECK(2 * p == p + p);
+    CHECK(p / 2.0 * 2 == p);
+
+    auto mixed = p + scalr::quantity_vec3<double, scalr::unit::centimeters>(
+                         scalr::centimeters(50), scalr::centimeters(0),
+                         scalr::centimeters(0));
+
+    STATIC_CHECK(std::is_same<decltype(mixed)::unit,
+                              scalr::unit::centimeters>::value);
+    CHECK(mixed.x() == scalr::centimeters(150));
+
+    p += q;
+    CHECK(p.z() == scalr::meters(4));
+
+    velocity v = p / scalr::duration<double>(2);
+    CHECK(v.y() == scalr::meters_per_second(2));
+  }
+
+  SECTION("Products") {
+    position r(scalr::meters(1), scalr::meters(0), scalr::meters(0));
+    scalr::quantity_vec3<double, scalr::unit::newtons> f(
+        scalr::newtons(0), scalr::newtons(2), scalr::newtons(0));
+
+    auto work = scalr::dot(r, f);
+    auto torque = scalr::cross(r, f);
+
+    STATIC_CHECK(std::is_same<decltype(work)::dimension,
+                              decltype(torque)::dimension>::value);
+    CHECK(work.value() == 0.0);
+    CHECK(torque.z().value() == 2.0);
+    CHECK(scalr::dot(f, f).value() == 4.0);
+
+    position d(scalr::meters(3), scalr::meters(4), scalr::meters(0));
+    auto length = scalr::norm(d);
+
+    STATIC_CHECK(std::is_same<decltype(length), scalr::meters>::value);
+    CHECK(length.value() == Catch::Approx(5.0));
+
+    acceleration a(scalr::meters_per_second_squared(0),
+                   scalr::meters_per_second_squared(0),
+                   scalr::meters_per_second_squared(-10));
+    auto weight = scalr::kilograms(2) * a;
+
+    STATIC_CHECK(std::is_same<decltype(weight)::dimension,
+                              scalr::force_dimension>::value);
+    CHECK(weight.z() == scalr::newtons(-20));
+  }
+
+  SECTION("Batch Layout") {
+    const std::size_t n = 19;
+    scalr::quantity_vector<double, scalr::unit::kilograms> masses;
+    scalr::quantity_vec_array<double, scalr::unit::meters_per_second_squared,
+                              3>
+        accelerations(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      masses.push_back(scalr::kilograms(double(i)));
+      accelerations.set(i, acceleration(scalr::meters_per_second_squared(1),
+                                        scalr::meters_per_second_squared(2),
+                                        scalr::meters_per_second_squared(3)));
+    }
+
+    CHECK(accelerations.block_count() == 3);
+
+    auto forces = scalr::multiply(masses.data(), accelerations);
+
+    CHECK(forces.size() == n);
+    CHECK(forces.get(18).z() == scalr::newtons(54));
+    CHECK(forces.get(7).x() == scalr::newtons(7));
+  }
+}
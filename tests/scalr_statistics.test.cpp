@@ -0,0 +1,96 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Streaming Statistics") {
+  // Mean 5 m, population variance 4 m^2
+  std::vector<scalr::meters> xs;
+  for (double x : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+    xs.push_back(scalr::meters(x));
+  }
+
+  SECTION("Moments") {
+    scalr::running_moments<scalr::meters> m;
+    for (const auto& x : xs) {
+      m.push(x);
+    }
+
+    STATIC_CHECK(std::is_same<decltype(m.variance()),
+                              scalr::square_meters>::value);
+    STATIC_CHECK(std::is_same<decltype(m.stddev()), scalr::meters>::value);
+    CHECK(m.count() == 8);
+    CHECK(m.mean().value() == 5.0);
+    CHECK(m.variance().value() == 4.0);
+    CHECK(m.sample_variance().value() == Catch::Approx(32.0 / 7));
+    CHECK(m.stddev().value() == 2.0);
+
+    // Samples in other units are converted to the unit of the stream
+    m.push(scalr::centimeters(500));
+    CHECK(m.mean().value() == 5.0);
+  }
+
+  SECTION("Batch and merge") {
+    scalr::running_moments<scalr::meters> batch;
+    batch.push(xs.begin(), xs.end());
+    CHECK(batch.count() == 8);
+    CHECK(batch.mean().value() == Catch::Approx(5.0));
+    CHECK(batch.variance().value() == Catch::Approx(4.0));
+
+    // Streams split at an odd point and merged agree with a single pass
+    scalr::running_moments<scalr::meters> left, right;
+    left.push(xs.begin(), xs.begin() + 3);
+    right.push(xs.begin() + 3, xs.end());
+    left.merge(right);
+    CHECK(left.count() == 8);
+    CHECK(left.mean().value() == Catch::Approx(5.0));
+    CHECK(left.variance().value() == Catch::Approx(4.0));
+
+    // Batches continue an existing stream
+    scalr::running_moments<scalr::meters> mixed;
+    mixed.push(xs[0]);
+    mixed.push(xs.begin() + 1, xs.end());
+    CHECK(mixed.variance().value() == Catch::Approx(4.0));
+
+    // Large offsets do not cancel catastrophically
+    scalr::running_moments<scalr::meters> offset;
+    std::vector<scalr::meters> shifted;
+    for (const auto& x : xs) {
+      shifted.push_back(x + scalr::meters(1e9));
+    }
+    offset.push(shifted.begin(), shifted.end());
+    CHECK(offset.variance().value() == Catch::Approx(4.0));
+  }
+
+  SECTION("Covariance") {
+    // Force proportional to displacement
+    std::vector<scalr::newtons> fs;
+    for (const auto& x : xs) {
+      fs.push_back(scalr::newtons(3 * x.value()));
+    }
+
+    scalr::running_covariance<scalr::meters, scalr::newtons> c;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      c.push(xs[i], fs[i]);
+    }
+
+    auto cov = c.covariance();
+    STATIC_CHECK(std::is_same<decltype(cov)::dimension,
+                              scalr::dimension_product_t<
+                                  scalr::length_dimension,
+                                  scalr::force_dimension>>::value);
+    CHECK(c.x_mean().value() == 5.0);
+    CHECK(c.y_mean().value() == 15.0);
+    CHECK(cov.value() == Catch::Approx(12.0));
+    CHECK(c.sample_covariance().value() == Catch::Approx(96.0 / 7));
+
+    scalr::running_covariance<scalr::meters, scalr::newtons> left, right;
+    left.push(xs.begin(), xs.begin() + 5, fs.begin());
+    right.push(xs.begin() + 5, xs.end(), fs.begin() + 5);
+    left.merge(right);
+    CHECK(left.count() == 8);
+    CHECK(left.covariance().value() == Catch::Approx(12.0));
+  }
+}
@@ -0,0 +1,73 @@
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "scalr/scalr.hpp"
+
+using namespace scalr::literals;
+
+TEST_CASE("Trigonometry") {
+  SECTION("Sine and Cosine") {
+    CHECK(scalr::sin(scalr::degrees(90)) == 1.0);
+    CHECK(scalr::cos(scalr::degrees(180)) == -1.0);
+    CHECK(scalr::sin(scalr::degrees(270)) == -1.0);
+    CHECK(scalr::cos(scalr::reduced_radians(1.0)) == 1.0);
+    CHECK(scalr::sin(scalr::gradians(-100)) == -1.0);
+    CHECK(scalr::sin(scalr::degrees(30)) == Catch::Approx(0.5));
+    CHECK(scalr::cos(scalr::degrees(60)) == Catch::Approx(0.5));
+    CHECK(scalr::tan(scalr::degrees(45)) == Catch::Approx(1.0));
+
+    // Whole periods in degrees are removed exactly
+    CHECK(scalr::sin(scalr::degrees(360.0 * 1e9 + 30)) == Catch::Approx(0.5));
+    CHECK(scalr::sin(scalr::angle<int, std::ratio<1, 360>>(720 + 90)) == 1.0);
+
+    for (int i = -720; i <= 720; i += 7) {
+      const double x = i * 3.14159265358979323846 / 180;
+      CHECK(scalr::sin(scalr::degrees(i)) ==
+            Catch::Approx(std::sin(x)).margin(1e-15));
+      CHECK(scalr::cos(scalr::degrees(i)) ==
+            Catch::Approx(std::cos(x)).margin(1e-15));
+    }
+
+    auto result = scalr::sincos(scalr::radians(1.0));
+
+    CHECK(result.first == Catch::Approx(std::sin(1.0)));
+    CHECK(result.second == Catch::Approx(std::cos(1.0)));
+  }
+
+  SECTION("Arc Tangent") {
+    auto turns = scalr::atan2(scalr::meters(1), scalr::meters(1));
+    auto deg = scalr::atan2<scalr::degrees>(scalr::meters(1),
+                                            scalr::centimeters(-100));
+
+    STATIC_CHECK(std::is_same<decltype(turns), scalr::reduced_radians>::value);
+    CHECK(turns.value() == Catch::Approx(0.125));
+    CHECK(deg.value() == Catch::Approx(135.0));
+  }
+
+  SECTION("Batch Functions") {
+    std::vector<scalr::degrees> angles{scalr::degrees(0), scalr::degrees(90),
+                                       scalr::degrees(180),
+                                       scalr::degrees(270)};
+    std::vector<double> sines(angles.size());
+    std::vector<double> cosines(angles.size());
+
+    scalr::sin(angles.begin(), angles.end(), sines.begin());
+    CHECK(sines == std::vector<double>{0, 1, 0, -1});
+
+    scalr::sincos(angles.begin(), angles.end(), sines.begin(),
+                  cosines.begin());
+    CHECK(cosines == std::vector<double>{1, 0, -1, 0});
+
+    std::vector<scalr::meters> ys{scalr::meters(1), scalr::meters(0)};
+    std::vector<scalr::meters> xs{scalr::meters(0), scalr::meters(-1)};
+    std::vector<scalr::degrees> result(ys.size());
+
+    scalr::atan2<scalr::degrees>(ys.begin(), ys.end(), xs.begin(),
+                                 result.begin());
+    CHECK(result[0].value() == Catch::Approx(90.0));
+    CHECK(result[1].value() == Catch::Approx(180.0));
+  }
+}
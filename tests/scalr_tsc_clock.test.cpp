@@ -0,0 +1,51 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("TSC Clock") {
+  using ticks = scalr::tsc_clock::ticks;
+
+  SECTION("Readings") {
+    const ticks a = scalr::tsc_clock::now();
+    const ticks b = scalr::tsc_clock::now();
+    CHECK(a.value() <= b.value());
+    CHECK(scalr::tsc_clock::calibrate() > 0);
+  }
+
+  SECTION("Conversion") {
+    // Synthetic tick counts scale by the calibrated period, independently of
+    // how long anything took
+    using milliseconds = scalr::duration<double, std::milli>;
+    const double period = scalr::tsc_clock::calibrate();
+    CHECK(scalr::tsc_clock::to_duration(ticks(0)).value() == 0);
+    CHECK(scalr::tsc_clock::to_duration<milliseconds>(ticks(1000000))
+              .value() == Catch::Approx(period));
+    CHECK(scalr::tsc_clock::to_duration<milliseconds>(ticks(-3000000))
+              .value() == Catch::Approx(-3 * period));
+    CHECK(scalr::tsc_clock::to_duration(ticks(1000000000)).value() ==
+          static_cast<std::int64_t>(1e9 * period));
+    CHECK(scalr::tsc_clock::calibrate() == period);
+  }
+
+  SECTION("Scoped timers") {
+    ticks total(0);
+    scalr::atomic_quantity<std::int64_t, ticks::unit> shared;
+    scalr::sharded_counter<std::int64_t, ticks::unit, 4> sharded;
+    {
+      scalr::scoped_timer<ticks> t1(total);
+      scalr::scoped_timer<decltype(shared)> t2(shared);
+      scalr::scoped_timer<decltype(sharded)> t3(sharded);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    CHECK(total.value() > 0);
+    CHECK(scalr::tsc_clock::to_duration(total).value() > 0);
+    CHECK(shared.load().value() > 0);
+    CHECK(sharded.load().value() > 0);
+  }
+}
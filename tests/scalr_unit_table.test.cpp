@@ -0,0 +1,55 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+TEST_CASE("Unit Tables") {
+  using speed_units = scalr::named_units_t<scalr::speed_dimension>;
+
+  SECTION("Registry") {
+    STATIC_CHECK(
+        std::is_same<speed_units,
+                     scalr::unit_list<scalr::unit::meters_per_second,
+                                      scalr::unit::kilometers_per_hour,
+                                      scalr::unit::miles_per_hour>>::value);
+    STATIC_CHECK(scalr::unit_id<scalr::unit::meters_per_second>::value == 0);
+    STATIC_CHECK(scalr::unit_id<scalr::unit::miles_per_hour>::value == 2);
+    STATIC_CHECK(scalr::unit_id<scalr::kilometers_per_hour::unit>::value == 1);
+    STATIC_CHECK(scalr::unit_table<scalr::length_dimension>::size == 12);
+    STATIC_CHECK(std::is_same<scalr::named_units_t<scalr::jerk_dimension>,
+                              scalr::unit_list<>>::value);
+  }
+
+  SECTION("Conversion") {
+    constexpr std::size_t mps =
+        scalr::unit_id<scalr::unit::meters_per_second>::value;
+    constexpr std::size_t kmh =
+        scalr::unit_id<scalr::unit::kilometers_per_hour>::value;
+    constexpr std::size_t mph =
+        scalr::unit_id<scalr::unit::miles_per_hour>::value;
+
+    std::vector<double> values{0, 10, 36};
+    std::vector<double> out(values.size());
+    scalr::convert<scalr::speed_dimension>(values.begin(), values.end(),
+                                           out.begin(), kmh, mps);
+    CHECK(out[1] == Catch::Approx(10.0 / 3.6));
+    CHECK(out[2] == Catch::Approx(10.0));
+
+    // Run-time conversions agree with compile-time casts
+    const scalr::meters_per_second v(12.5);
+    CHECK(scalr::convert(v, mph) ==
+          Catch::Approx(scalr::miles_per_hour(v).value()));
+    CHECK(scalr::convert(v, kmh) == Catch::Approx(45.0));
+
+    // Radians carry a power of pi
+    constexpr std::size_t deg = scalr::unit_id<scalr::unit::degrees>::value;
+    CHECK(scalr::convert(scalr::radians(scalr::detail::pi), deg) ==
+          Catch::Approx(180.0));
+
+    CHECK(scalr::unit_table<scalr::length_dimension>::factor(
+              scalr::unit_id<scalr::unit::miles>::value,
+              scalr::unit_id<scalr::unit::feet>::value) == 5280.0);
+  }
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "scalr/scalr.hpp"
+
+namespace {
+
+struct window_record {
+  scalr::milliseconds start;
+  std::size_t count;
+  double sum;
+  double min;
+  double max;
+  double last;
+};
+
+struct collector {
+  std::vector<window_record>* records;
+
+  void operator()(const scalr::milliseconds& start,
+                  const scalr::window_aggregate<scalr::watts>& w) const {
+    records->push_back(window_record{start, w.count(), w.sum().value(),
+                                     w.min().value(), w.max().value(),
+                                     w.last().value()});
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Window Aggregation") {
+  using ms = scalr::milliseconds;
+
+  // Power samples at 0, 400, ..., 2800 ms with values 0, 1, ..., 7 W
+  std::vector<ms> ts;
+  std::vector<scalr::watts> ps;
+  for (int i = 0; i < 8; ++i) {
+    ts.push_back(ms(400 * i));
+    ps.push_back(scalr::watts(i));
+  }
+
+  SECTION("Aggregate") {
+    scalr::window_aggregate<scalr::watts> a, b;
+    a.push(scalr::watts(3));
+    a.push(scalr::kilowatts(0.001));
+    b.push(scalr::watts(5));
+    a.merge(b);
+
+    CHECK(a.count() == 3);
+    CHECK(a.sum().value() == 9.0);
+    CHECK(a.min().value() == 1.0);
+    CHECK(a.max().value() == 5.0);
+    CHECK(a.last().value() == 5.0);
+    CHECK(a.mean().value() == 3.0);
+  }
+
+  SECTION("Tumbling") {
+    std::vector<window_record> out;
+    scalr::tumbling_window<scalr::watts, ms> w(scalr::seconds(1));
+    for (std::size_t i = 0; i < ts.size(); ++i) {
+      w.push(ts[i], ps[i], collector{&out});
+    }
+    // A gap of several windows is skipped
+    w.push(ms(7300), scalr::watts(10), collector{&out});
+    w.flush(collector{&out});
+
+    REQUIRE(out.size() == 4);
+    CHECK(out[0].start.value() == 0);
+    CHECK(out[0].count == 3);
+    CHECK(out[0].sum == 3.0);
+    CHECK(out[1].start.value() == 1000);
+    CHECK(out[1].min == 3.0);
+    CHECK(out[1].max == 4.0);
+    CHECK(out[2].start.value() == 2000);
+    CHECK(out[2].last == 7.0);
+    CHECK(out[3].start.value() == 7000);
+    CHECK(out[3].count == 1);
+  }
+
+  SECTION("Before Epoch") {
+    // Timestamps before the epoch fall into the window that contains them
+    std::vector<window_record> out;
+    scalr::tumbling_window<scalr::watts, ms> w(scalr::seconds(1));
+    w.push(ms(-1500), scalr::watts(1), collector{&out});
+    w.push(ms(-1000), scalr::watts(2), collector{&out});
+    w.push(ms(-1), scalr::watts(3), collector{&out});
+    w.push(ms(0), scalr::watts(4), collector{&out});
+    w.flush(collector{&out});
+
+    REQUIRE(out.size() == 3);
+    CHECK(out[0].start.value() == -2000);
+    CHECK(out[1].start.value() == -1000);
+    CHECK(out[1].count == 2);
+    CHECK(out[2].start.value() == 0);
+    CHECK(out[2].sum == 4.0);
+
+    std::vector<window_record> slid;
+    scalr::sliding_window<scalr::watts, ms> s(scalr::seconds(2), ms(1000));
+    s.push(ms(-300), scalr::watts(1), collector{&slid});
+    s.flush(collector{&slid});
+    REQUIRE(slid.size() == 2);
+    CHECK(slid[0].start.value() == -2000);
+    CHECK(slid[1].start.value() == -1000);
+  }
+
+  SECTION("Sliding") {
+    std::vector<window_record> out;
+    scalr::sliding_window<scalr::watts, ms> w(scalr::seconds(2), ms(1000));
+    for (std::size_t i = 0; i < ts.size(); ++i) {
+      w.push(ts[i], ps[i], collector{&out});
+    }
+    w.flush(collector{&out});
+
+    // Windows [-1, 1), [0, 2), [1, 3) and [2, 4) seconds
+    REQUIRE(out.size() == 4);
+    CHECK(out[0].start.value() == -1000);
+    CHECK(out[0].count == 3);
+    CHECK(out[1].start.value() == 0);
+    CHECK(out[1].count == 5);
+    CHECK(out[1].sum == 10.0);
+    CHECK(out[2].start.value() == 1000);
+    CHECK(out[2].min == 3.0);
+    CHECK(out[2].max == 7.0);
+    CHECK(out[3].start.value() == 2000);
+    CHECK(out[3].count == 3);
+  }
+
+  SECTION("Session") {
+    std::vector<window_record> out;
+    scalr::session_window<scalr::watts, ms> w(ms(500));
+    w.push(ms(0), scalr::watts(1), collector{&out});
+    w.push(ms(400), scalr::watts(2), collector{&out});
+    w.push(ms(1000), scalr::watts(3), collector{&out});
+    w.push(ms(1500), scalr::watts(4), collector{&out});
+    w.flush(collector{&out});
+
+    REQUIRE(out.size() == 2);
+    CHECK(out[0].start.value() == 0);
+    CHECK(out[0].sum == 3.0);
+    CHECK(out[1].start.value() == 1000);
+    CHECK(out[1].count == 2);
+  }
+}